@@ -23,6 +23,11 @@
 #include "pico/time.h"
 
 #include "ili9225.h"
+#include "ili9225_color.h"
+#include "ili9225_cursor.h"
+#include "ili9225_font8x8.h"
+#include "ili9225_line_buf.h"
+#include "ili9225_utf8.h"
 
 /* Register Descriptions. */
 /**
@@ -251,6 +256,17 @@
 #define MK_ILI9225_REG_MTP_CTRL_REG		0x81
 #define MK_ILI9225_REG_MTP_DATA_READ		0x82
 
+/* Register bits. */
+#define DRV_OUT_GS		0x0200
+#define DRV_OUT_SS		0x0100
+#define DRV_OUT_NL_MASK		0x001F
+#define ENTRY_MODE_BGR		0x1000
+#define ENTRY_MODE_ID_INC	0x0030
+#define ENTRY_MODE_AM		0x0008
+#define DISPLAY_CTRL_CL		0x0008
+#define OSC_CTRL_EN		0x0001
+#define OSC_CTRL_FOSC_SHIFT	8
+
 /* Useful macros. */
 #define ARRAYSIZE(array)    (sizeof(array)/sizeof(array[0]))
 
@@ -269,13 +285,66 @@ static void write_data(uint16_t dat);
 static uint16_t read_data(void);
 static uint16_t get_register(uint16_t reg);
 #endif
+static void stream_begin(uint8_t x, uint8_t y, uint8_t w, uint8_t h,
+	bool columns);
 
 static int dma_irq;
 static uint dma_tx;
 static dma_channel_config c;
 
+/* Channel used for line streaming. It never raises an interrupt, so it does
+ * not disturb the callback installed with ili9225_set_dma_irq_handler(). */
+static uint dma_line;
+static dma_channel_config line_c;
+static dma_channel_config repeat_c;
+uint16_t ili9225_line_buf[2][LINE_MAX_PX];
+
+/* Rectangle being streamed, and the next line or column to be sent. */
+static struct {
+	uint8_t x, y, w, h;
+	bool columns;
+	/* Pixels sent so far. */
+	uint32_t pos;
+	/* Source of ili9225_stream_repeat(), kept until the transfer ends. */
+	uint16_t repeat_color;
+} stream;
+
 static ili9225_dma_finish_callback_t f_dma_finish_callback;
 
+/* Copies of write-only registers that are changed at run time. */
+static uint16_t drv_out_ctrl;
+static uint16_t entry_mode;
+static uint16_t display_ctrl;
+static uint16_t osc_ctrl;
+
+/* Settings restored by ili9225_full_display(). */
+static struct {
+	bool active;
+	uint16_t display_ctrl;
+	uint16_t osc_ctrl;
+} partial;
+
+/* State of the adaptive refresh mode; see ili9225_refresh_adaptive(). */
+static struct {
+	bool enabled;
+	bool idle;
+	struct ili9225_refresh_config cfg;
+	/* Full rate settings restored on wake. */
+	uint16_t osc_ctrl;
+	uint32_t baudrate;
+	/* time_us_32() of the last GRAM write. */
+	uint32_t last_update;
+	/* Updates counted towards waking while idle. */
+	uint32_t window_start;
+	uint16_t window_updates;
+} refresh;
+
+/* ENTRY_MODE for row by row updates in the current rotation. */
+static uint16_t entry_mode_rows;
+
+/* Whether screen x runs along the GRAM vertical address. */
+static bool swap_xy;
+
 static void _ili9225_dma_finish_callback(void)
 {
 	ili9225_write_pixels_end();
@@ -352,6 +421,111 @@ static void set_register(uint16_t reg, uint16_t dat)
 	write_data(dat);
 }
 
+/**
+ * Wait for a transfer started by ili9225_dma_write() to leave the SPI, so that
+ * a register write or a baud rate change does not land in the middle of it.
+ */
+static void wait_bus_idle(void)
+{
+	dma_channel_wait_for_finish_blocking(dma_tx);
+
+	/* DMA completion only means the last halfword entered the TX FIFO. */
+	while(spi_is_busy(ili9225_cfg.spi))
+		tight_loop_contents();
+}
+
+static void refresh_wake(void)
+{
+	wait_bus_idle();
+
+	if(refresh.cfg.idle_baudrate != 0)
+		spi_set_baudrate(ili9225_cfg.spi, refresh.baudrate);
+
+	osc_ctrl = refresh.osc_ctrl;
+	set_register(MK_ILI9225_REG_OSC_CTRL, osc_ctrl);
+	refresh.idle = false;
+}
+
+/**
+ * Called before every GRAM write. While idle, only a burst of updates restores
+ * the full rate, so that an occasional redraw such as a clock ticking over
+ * does not make the refresh rate toggle.
+ */
+static void refresh_activity(void)
+{
+	uint32_t now;
+
+	if(!refresh.enabled)
+		return;
+
+	now = time_us_32();
+	refresh.last_update = now;
+
+	if(!refresh.idle)
+		return;
+
+	if(now - refresh.window_start >= refresh.cfg.wake_window_ms * 1000u)
+	{
+		refresh.window_start = now;
+		refresh.window_updates = 0;
+	}
+
+	if(++refresh.window_updates >= refresh.cfg.wake_updates)
+		refresh_wake();
+}
+
+static void begin_gram_write(void)
+{
+	refresh_activity();
+	write_register(MK_ILI9225_REG_GRAM_RW);
+}
+
+/**
+ * GRAM is addressed horizontally along the 176 px side and vertically along
+ * the 220 px side. Landscape orientations swap screen x and y with respect to
+ * those; any mirroring is done by the panel (see ili9225_set_rotation()).
+ */
+static void set_window_regs(uint8_t x0, uint8_t x1, uint8_t y0, uint8_t y1)
+{
+	if(swap_xy)
+	{
+		uint8_t t;
+		t = x0; x0 = y0; y0 = t;
+		t = x1; x1 = y1; y1 = t;
+	}
+
+	set_register(MK_ILI9225_REG_HORI_WIN_ADDR1, x1);
+	set_register(MK_ILI9225_REG_HORI_WIN_ADDR2, x0);
+	set_register(MK_ILI9225_REG_VERT_WIN_ADDR1, y1);
+	set_register(MK_ILI9225_REG_VERT_WIN_ADDR2, y0);
+	set_register(MK_ILI9225_REG_RAM_ADDR_SET1, x0);
+	set_register(MK_ILI9225_REG_RAM_ADDR_SET2, y0);
+}
+
+/**
+ * Select whether GRAM is updated row by row or column by column. The register
+ * is only written when the direction changes.
+ */
+static void set_scan_columns(bool columns)
+{
+	uint16_t entry = entry_mode_rows;
+
+	if(columns)
+		entry ^= ENTRY_MODE_AM;
+
+	if(entry == entry_mode)
+		return;
+
+	entry_mode = entry;
+	set_register(MK_ILI9225_REG_ENTRY_MODE, entry_mode);
+}
+
+static void set_address_regs(uint8_t x, uint8_t y)
+{
+	set_register(MK_ILI9225_REG_RAM_ADDR_SET1, swap_xy ? y : x);
+	set_register(MK_ILI9225_REG_RAM_ADDR_SET2, swap_xy ? x : y);
+}
+
 #if MK_ILI9225_READ_AVAILABLE
 unsigned ili9225_read_driving_line(void)
 {
@@ -462,13 +636,15 @@ unsigned ili9225_init(const struct ili9225_config *config)
 	{
 		const struct reg_dat_pair cmds[] = {
 			/* Set shift direction SS from S528 to S1.
-			 * Set active lines NL to 528 * 220 dots. */
+			 * Set active lines NL to 528 * 220 dots.
+			 * GS is set by ili9225_set_rotation() below. */
 			{ MK_ILI9225_REG_DRIVER_OUTPUT_CTRL,	0x011C },
 			/* Set LCD inversion to disabled. */
 			{ MK_ILI9225_REG_LCD_AC_DRIVING_CTRL,	0x0100 },
 			/* Increment vertical and horizontal address.
-			 * Use vertical image. */
-			{ MK_ILI9225_REG_ENTRY_MODE,		0x1018 },
+			 * Use horizontal image; ili9225_set_rotation()
+			 * selects the final direction. */
+			{ MK_ILI9225_REG_ENTRY_MODE,		0x1030 },
 			/* Turn off all display outputs. */
 			{ MK_ILI9225_REG_DISPLAY_CTRL,		0x0000 },
 			/* Set porches to 8 lines. */
@@ -525,6 +701,11 @@ unsigned ili9225_init(const struct ili9225_config *config)
 	}
 	ili9225_delay_ms(50);
 
+	/* Landscape, as expected by the drawing functions before rotation
+	 * could be selected. */
+	drv_out_ctrl = 0x011C;
+	ili9225_set_rotation(ILI9225_ROTATION_90);
+
 	/**
 	 * FIXME: TEMON is enabled but FLM isn't exposed?
 	 * GON: Enable display.
@@ -532,7 +713,12 @@ unsigned ili9225_init(const struct ili9225_config *config)
 	 * REV: reverse greyscale levels.
 	 * D: Switch on display.
 	 */
-	set_register(MK_ILI9225_REG_DISPLAY_CTRL, 0x1017);
+	display_ctrl = 0x1017;
+	set_register(MK_ILI9225_REG_DISPLAY_CTRL, display_ctrl);
+	osc_ctrl = 0x0701;
+	partial.active = false;
+	refresh.enabled = false;
+	refresh.idle = false;
 	ili9225_delay_ms(50);
 	
 	/* Turn on backlight */
@@ -548,9 +734,20 @@ unsigned ili9225_init(const struct ili9225_config *config)
 	// DMA Configuration
 	{
 		// Setup the data channel
+		dma_tx = dma_claim_unused_channel(true);
 		c = dma_channel_get_default_config(dma_tx);  // Default configs
 		channel_config_set_transfer_data_size(&c, DMA_SIZE_16);          // 16-bit txfers
 		channel_config_set_dreq(&c, spi_get_dreq(ili9225_cfg.spi, true));
+
+		// Setup the line streaming channel
+		dma_line = dma_claim_unused_channel(true);
+		line_c = dma_channel_get_default_config(dma_line);
+		channel_config_set_transfer_data_size(&line_c, DMA_SIZE_16);
+		channel_config_set_dreq(&line_c, spi_get_dreq(ili9225_cfg.spi, true));
+
+		// Same channel, sending one colour repeatedly
+		repeat_c = line_c;
+		channel_config_set_read_increment(&repeat_c, false);
 	}
 
 	return ret;
@@ -561,6 +758,7 @@ void ili9225_display_control(bool invert, ili9225_color_mode_e colour_mode)
 	uint16_t dat = 0x0013;
 	dat |= ((uint16_t)invert << 2);
 	dat |= ((uint16_t)colour_mode << 3);
+	display_ctrl = dat;
 	set_register(MK_ILI9225_REG_DISPLAY_CTRL, dat);
 }
 
@@ -610,31 +808,89 @@ void ili9225_set_cs(bool state)
 	gpio_put(ili9225_cfg.gpio_cs, state);
 }
 
+void ili9225_set_rotation(ili9225_rotation_e rotation)
+{
+	/* GS and SS mirror the panel so that the screen origin is always at
+	 * GRAM address 0. Landscape orientations swap the axes; AM then makes
+	 * the address counter move along the screen row. */
+	uint16_t out = drv_out_ctrl & ~(DRV_OUT_SS | DRV_OUT_GS);
+	uint16_t entry = ENTRY_MODE_BGR | ENTRY_MODE_ID_INC;
+
+	switch(rotation)
+	{
+	default:
+	case ILI9225_ROTATION_0:
+		out |= DRV_OUT_SS;
+		break;
+
+	case ILI9225_ROTATION_90:
+		out |= DRV_OUT_SS | DRV_OUT_GS;
+		entry |= ENTRY_MODE_AM;
+		break;
+
+	case ILI9225_ROTATION_180:
+		out |= DRV_OUT_GS;
+		break;
+
+	case ILI9225_ROTATION_270:
+		entry |= ENTRY_MODE_AM;
+		break;
+	}
+
+	swap_xy = (entry & ENTRY_MODE_AM) != 0;
+	drv_out_ctrl = out;
+	entry_mode = entry;
+	entry_mode_rows = entry;
+	set_register(MK_ILI9225_REG_DRIVER_OUTPUT_CTRL, drv_out_ctrl);
+	set_register(MK_ILI9225_REG_ENTRY_MODE, entry_mode);
+	set_window_regs(0, ili9225_width() - 1, 0, ili9225_height() - 1);
+	ili9225_scroll_region(0, SCREEN_SIZE_Y - 1, 0);
+}
+
+uint8_t ili9225_width(void)
+{
+	return swap_xy ? SCREEN_SIZE_Y : SCREEN_SIZE_X;
+}
+
+uint8_t ili9225_height(void)
+{
+	return swap_xy ? SCREEN_SIZE_X : SCREEN_SIZE_Y;
+}
+
+void ili9225_scroll_region(uint8_t top, uint8_t bottom, uint8_t offset)
+{
+	/* Scrolling moves gate lines, which are screen rows in portrait
+	 * rotations and columns in landscape ones. GS mirrors the panel but
+	 * not the scroll, so the values do not depend on the rotation. */
+	assert(top <= bottom && bottom < SCREEN_SIZE_Y);
+	assert(offset <= bottom - top);
+
+	set_register(MK_ILI9225_REG_VERT_SCROLL_CTRL1, bottom);
+	set_register(MK_ILI9225_REG_VERT_SCROLL_CTRL2, top);
+	set_register(MK_ILI9225_REG_VERT_SCROLL_CTRL3, offset);
+}
+
 void ili9225_set_window(uint16_t hor_start, uint16_t hor_end,
 	uint16_t vert_start, uint16_t vert_end)
 {
-	assert(hor_start < hor_end);
-	assert(hor_end < SCREEN_SIZE_X);
-	assert(vert_start < vert_end);
-	assert(vert_end < SCREEN_SIZE_Y);
+	assert(hor_start <= hor_end);
+	assert(hor_end < ili9225_width());
+	assert(vert_start <= vert_end);
+	assert(vert_end < ili9225_height());
 
-	set_register(MK_ILI9225_REG_HORI_WIN_ADDR1, hor_end);
-	set_register(MK_ILI9225_REG_HORI_WIN_ADDR2, hor_start);
-	set_register(MK_ILI9225_REG_VERT_WIN_ADDR1, vert_end);
-	set_register(MK_ILI9225_REG_VERT_WIN_ADDR2, vert_start);
-	set_register(MK_ILI9225_REG_RAM_ADDR_SET1, hor_start);
-	set_register(MK_ILI9225_REG_RAM_ADDR_SET2, vert_start);
+	set_scan_columns(false);
+	set_window_regs(hor_start, hor_end, vert_start, vert_end);
 }
 
 void ili9225_set_x(uint8_t x)
 {
-	set_register(MK_ILI9225_REG_RAM_ADDR_SET1, x);
+	set_register(swap_xy ? MK_ILI9225_REG_RAM_ADDR_SET2 :
+		MK_ILI9225_REG_RAM_ADDR_SET1, x);
 }
 
 void ili9225_set_address(uint8_t x, uint8_t y)
 {
-	set_register(MK_ILI9225_REG_RAM_ADDR_SET1, x);
-	set_register(MK_ILI9225_REG_RAM_ADDR_SET2, y);
+	set_address_regs(x, y);
 }
 
 void ili9225_write_pixels(const uint16_t *pixels, uint_fast16_t nmemb)
@@ -642,7 +898,7 @@ void ili9225_write_pixels(const uint16_t *pixels, uint_fast16_t nmemb)
 	assert(pixels != NULL);
 	assert(nmemb > 0);
 
-	write_register(MK_ILI9225_REG_GRAM_RW);
+	begin_gram_write();
 	ili9225_set_rs(1);
 	ili9225_set_cs(0);
 	ili9225_spi_write16(pixels, nmemb);
@@ -651,7 +907,7 @@ void ili9225_write_pixels(const uint16_t *pixels, uint_fast16_t nmemb)
 
 void ili9225_write_pixels_start(void)
 {
-	write_register(MK_ILI9225_REG_GRAM_RW);
+	begin_gram_write();
 	ili9225_set_rs(1);
 	ili9225_set_cs(0);
 }
@@ -671,736 +927,459 @@ void ili9225_power_control(uint8_t drive_power, bool sleep)
 
 void ili9225_set_gate_scan(uint16_t hor_start, uint16_t hor_end)
 {
-	uint16_t dat = 0x0100;
 	uint16_t lcd_line_start = hor_end / 8;
-	set_register(MK_ILI9225_REG_DRIVER_OUTPUT_CTRL, dat | lcd_line_start);
+	drv_out_ctrl = (drv_out_ctrl & ~DRV_OUT_NL_MASK) | lcd_line_start;
+	set_register(MK_ILI9225_REG_DRIVER_OUTPUT_CTRL, drv_out_ctrl);
 	set_register(MK_ILI9225_REG_GATE_SCAN_CTRL, hor_start / 8);
 }
 
 void ili9225_set_drive_freq(uint16_t f)
 {
 	f &= 0x000F;
-	f <<= 8;
-	f |= 1;
+	f <<= OSC_CTRL_FOSC_SHIFT;
+	f |= OSC_CTRL_EN;
+
+	if(refresh.idle)
+		refresh_wake();
+
+	osc_ctrl = f;
 	set_register(MK_ILI9225_REG_OSC_CTRL, f);
 }
 
+void ili9225_partial_display(uint8_t first, uint8_t last,
+	ili9225_color_mode_e colour_mode, uint16_t drive_freq)
+{
+	uint16_t dat;
+
+	assert(first <= last && last < SCREEN_SIZE_Y);
+
+	if(refresh.idle)
+		refresh_wake();
+
+	if(!partial.active)
+	{
+		partial.display_ctrl = display_ctrl;
+		partial.osc_ctrl = osc_ctrl;
+		partial.active = true;
+	}
+
+	set_register(MK_ILI9225_REG_PART_DRIVING_POS1, last);
+	set_register(MK_ILI9225_REG_PART_DRIVING_POS2, first);
+
+	dat = partial.display_ctrl & ~DISPLAY_CTRL_CL;
+	if(colour_mode == ILI9225_COLOR_MODE_8COLOR)
+		dat |= DISPLAY_CTRL_CL;
+	display_ctrl = dat;
+	set_register(MK_ILI9225_REG_DISPLAY_CTRL, dat);
+
+	ili9225_set_drive_freq(drive_freq);
+}
+
+void ili9225_full_display(void)
+{
+	if(!partial.active)
+		return;
+
+	set_register(MK_ILI9225_REG_PART_DRIVING_POS1, SCREEN_SIZE_Y - 1);
+	set_register(MK_ILI9225_REG_PART_DRIVING_POS2, 0);
+
+	display_ctrl = partial.display_ctrl;
+	set_register(MK_ILI9225_REG_DISPLAY_CTRL, display_ctrl);
+	osc_ctrl = partial.osc_ctrl;
+	set_register(MK_ILI9225_REG_OSC_CTRL, osc_ctrl);
+
+	partial.active = false;
+}
+
+bool ili9225_is_partial_display(void)
+{
+	return partial.active;
+}
+
+uint16_t ili9225_get_drive_freq(void)
+{
+	return (osc_ctrl >> OSC_CTRL_FOSC_SHIFT) & 0x000F;
+}
+
+void ili9225_refresh_adaptive(const struct ili9225_refresh_config *cfg)
+{
+	if(refresh.idle)
+		refresh_wake();
+
+	refresh.enabled = (cfg != NULL);
+	if(cfg == NULL)
+		return;
+
+	assert(cfg->wake_updates > 0);
+	refresh.cfg = *cfg;
+	refresh.last_update = time_us_32();
+}
+
+void ili9225_refresh_poll(void)
+{
+	uint32_t now;
+
+	if(!refresh.enabled || refresh.idle || partial.active)
+		return;
+
+	now = time_us_32();
+	if(now - refresh.last_update < refresh.cfg.idle_after_ms * 1000u)
+		return;
+
+	wait_bus_idle();
+
+	refresh.osc_ctrl = osc_ctrl;
+	osc_ctrl = ((refresh.cfg.idle_freq & 0x000F) << OSC_CTRL_FOSC_SHIFT) |
+		OSC_CTRL_EN;
+	set_register(MK_ILI9225_REG_OSC_CTRL, osc_ctrl);
+
+	if(refresh.cfg.idle_baudrate != 0)
+	{
+		refresh.baudrate = spi_get_baudrate(ili9225_cfg.spi);
+		spi_set_baudrate(ili9225_cfg.spi, refresh.cfg.idle_baudrate);
+	}
+
+	refresh.idle = true;
+	refresh.window_start = now;
+	refresh.window_updates = 0;
+}
+
+bool ili9225_refresh_is_idle(void)
+{
+	return refresh.idle;
+}
+
 void ili9225_exit(void)
 {
 }
 
+/**
+ * Set the window and address counter for a rectangle. Pixels written to GRAM
+ * afterwards fill the rectangle left to right, top to bottom.
+ */
+static void set_rect_window(uint8_t x, uint8_t y, uint8_t w, uint8_t h)
+{
+	assert(w > 0 && h > 0);
+	assert(x + w <= ili9225_width());
+	assert(y + h <= ili9225_height());
+
+	set_window_regs(x, x + w - 1, y, y + h - 1);
+}
+
 void ili9225_fill_rect(uint8_t x,uint8_t y,uint8_t w,uint8_t h,uint16_t color)
 {
-	set_register(MK_ILI9225_REG_ENTRY_MODE,0x1018);
-	set_register(MK_ILI9225_REG_HORI_WIN_ADDR1, y+h-1);			// y_max
-	set_register(MK_ILI9225_REG_HORI_WIN_ADDR2, y);				// y_min
-	set_register(MK_ILI9225_REG_VERT_WIN_ADDR1, 219-x);			// x_max
-	set_register(MK_ILI9225_REG_VERT_WIN_ADDR2, 219-(x+w-1));	// x_min
-	set_register(MK_ILI9225_REG_RAM_ADDR_SET1,y);
-	set_register(MK_ILI9225_REG_RAM_ADDR_SET2,219-x);
-	write_register(MK_ILI9225_REG_GRAM_RW);
-	ili9225_set_rs(1);
-	ili9225_set_cs(0);
-	for(uint16_t i=0;i<w*h;i++) {
-		ili9225_spi_write16(&color,1);
-	}
-	ili9225_set_cs(1);
+	/* A solid fill looks the same in either update direction, so whichever
+	 * is currently set is kept. */
+	stream_begin(x, y, w, h, entry_mode != entry_mode_rows);
+	ili9225_stream_repeat(color, (size_t)w * h);
+	ili9225_stream_end();
 }
 
 void ili9225_fill(uint16_t color)
 {
-	ili9225_fill_rect(0,0,220,176,color);
+	ili9225_fill_rect(0,0,ili9225_width(),ili9225_height(),color);
 }
 
 void ili9225_pixel(uint8_t x,uint8_t y,uint16_t color)
 {
-	set_register(MK_ILI9225_REG_RAM_ADDR_SET1,y);
-	set_register(MK_ILI9225_REG_RAM_ADDR_SET2,219-x);
-	set_register(MK_ILI9225_REG_GRAM_RW,color);
+	set_address_regs(x, y);
+	begin_gram_write();
+	write_data(color);
+	ili9225_cursor_track(x, y, 1, 1, &color, ILI9225_CURSOR_SRC_SOLID);
 }
 
 void ili9225_blit(uint16_t *fbuf,uint8_t x,uint8_t y,uint8_t w,uint8_t h) {
-	set_register(MK_ILI9225_REG_ENTRY_MODE,0x1018);
-	set_register(MK_ILI9225_REG_HORI_WIN_ADDR1, y+h-1);			// y_max
-	set_register(MK_ILI9225_REG_HORI_WIN_ADDR2, y);				// y_min
-	set_register(MK_ILI9225_REG_VERT_WIN_ADDR1, 219-x);			// x_max
-	set_register(MK_ILI9225_REG_VERT_WIN_ADDR2, 219-(x+w-1));	// x_min
-	set_register(MK_ILI9225_REG_RAM_ADDR_SET1,y);
-	set_register(MK_ILI9225_REG_RAM_ADDR_SET2,219-x);
-	write_register(MK_ILI9225_REG_GRAM_RW);
+	set_scan_columns(false);
+	set_rect_window(x, y, w, h);
+	begin_gram_write();
 	ili9225_set_rs(1);
 	ili9225_set_cs(0);
 	ili9225_spi_write16(fbuf,w*h);
 	ili9225_set_cs(1);
+	ili9225_cursor_track(x, y, w, h, fbuf, ILI9225_CURSOR_SRC_ROWS);
 }
 
-void ili9225_get_letter(uint16_t *fbuf,char l,uint16_t color,uint16_t bgcolor) {
-	uint8_t letter[8];
-	uint8_t row;
-	
-	switch(l)
-	{
-		case 'a':
-		case 'A':
-		{
-			const uint8_t letter_[8]={0b00111100,
-						              0b01100110,
-						              0b01100110,
-						              0b01111110,
-						              0b01100110,
-						              0b01100110,
-						              0b01100110,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+void ili9225_blit_columns(const uint16_t *fbuf, uint8_t x, uint8_t y,
+	uint8_t w, uint8_t h)
+{
+	set_scan_columns(true);
+	set_rect_window(x, y, w, h);
+	begin_gram_write();
+	ili9225_set_rs(1);
+	ili9225_set_cs(0);
+	ili9225_spi_write16(fbuf, (size_t)w * h);
+	ili9225_set_cs(1);
+	ili9225_cursor_track(x, y, w, h, fbuf, ILI9225_CURSOR_SRC_COLUMNS);
+}
 
-		case 'b':
-		case 'B':
-		{
-			const uint8_t letter_[8]={0b01111100,
-						              0b01100110,
-						              0b01100110,
-						              0b01111100,
-						              0b01100110,
-						              0b01100110,
-						              0b01111100,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+void ili9225_blit_field(const uint16_t *fbuf, uint8_t x, uint8_t y,
+	uint8_t w, uint8_t h, unsigned field)
+{
+	/* Screen rows run along GRAM V, or H in landscape. */
+	const uint16_t row_reg = swap_xy ?
+		MK_ILI9225_REG_RAM_ADDR_SET1 : MK_ILI9225_REG_RAM_ADDR_SET2;
+	uint8_t r = (y ^ field) & 1;
 
-        case 'c':
-		case 'C':
-		{
-			const uint8_t letter_[8]={0b00011110,
-						              0b00110000,
-						              0b01100000,
-						              0b01100000,
-						              0b01100000,
-						              0b00110000,
-						              0b00011110,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	assert(field < 2);
 
-        case 'd':
-		case 'D':
-		{
-			const uint8_t letter_[8]={0b01111000,
-						              0b01101100,
-						              0b01100110,
-						              0b01100110,
-						              0b01100110,
-						              0b01101100,
-						              0b01111000,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	if(r >= h)
+		return;
 
-        case 'e':
-		case 'E':
-		{
-			const uint8_t letter_[8]={0b01111110,
-						              0b01100000,
-						              0b01100000,
-						              0b01111000,
-						              0b01100000,
-						              0b01100000,
-						              0b01111110,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	set_scan_columns(false);
+	set_rect_window(x, y, w, h);
 
-        case 'f':
-		case 'F':
-		{
-			const uint8_t letter_[8]={0b01111110,
-						              0b01100000,
-						              0b01100000,
-						              0b01111000,
-						              0b01100000,
-						              0b01100000,
-						              0b01100000,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	/* The address wraps to the start of the next row at the end of each
+	 * row, so only the row needs moving past the skipped one. */
+	for(; r < h; r += 2)
+	{
+		const uint16_t *row = fbuf + (size_t)r * w;
+
+		set_register(row_reg, y + r);
+		begin_gram_write();
+		ili9225_set_rs(1);
+		ili9225_set_cs(0);
+		ili9225_spi_write16(row, w);
+		ili9225_set_cs(1);
+		ili9225_cursor_track(x, y + r, w, 1, row,
+			ILI9225_CURSOR_SRC_ROWS);
+	}
+}
 
-        case 'g':
-		case 'G':
-		{
-			const uint8_t letter_[8]={0b00111100,
-						              0b01100110,
-						              0b01100000,
-						              0b01101110,
-						              0b01100110,
-						              0b01100110,
-						              0b00111110,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+static void stream_begin(uint8_t x, uint8_t y, uint8_t w, uint8_t h,
+	bool columns)
+{
+	/* A transfer started with ili9225_dma_write() must not be cut short. */
+	dma_channel_wait_for_finish_blocking(dma_tx);
+	set_scan_columns(columns);
+	set_rect_window(x, y, w, h);
+	ili9225_write_pixels_start();
 
-        case 'h':
-		case 'H':
-		{
-			const uint8_t letter_[8]={0b01100110,
-						              0b01100110,
-						              0b01100110,
-						              0b01111110,
-						              0b01100110,
-						              0b01100110,
-						              0b01100110,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	stream.x = x;
+	stream.y = y;
+	stream.w = w;
+	stream.h = h;
+	stream.columns = columns;
+	stream.pos = 0;
+}
 
-        case 'i':
-		case 'I':
-		{
-			const uint8_t letter_[8]={0b00111100,
-						              0b00011000,
-						              0b00011000,
-						              0b00011000,
-						              0b00011000,
-						              0b00011000,
-						              0b00111100,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+/**
+ * Record pixels sent to the stream window with the cursors. The pixels may
+ * start and end part way through a line, so they are split into a partial
+ * line, whole lines and another partial line.
+ */
+static void stream_track(const uint16_t *pixels, size_t len,
+	ili9225_cursor_src_e src)
+{
+	const size_t line_len = stream.columns ? stream.h : stream.w;
 
-        case 'j':
-		case 'J':
-		{
-			const uint8_t letter_[8]={0b00000110,
-						              0b00000110,
-						              0b00000110,
-						              0b00000110,
-						              0b00000110,
-						              0b01100110,
-						              0b00111100,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	while(len > 0)
+	{
+		const uint8_t line = stream.pos / line_len;
+		const uint8_t off = stream.pos % line_len;
+		size_t n;
 
-        case 'k':
-		case 'K':
+		if(off != 0 || len < line_len)
 		{
-			const uint8_t letter_[8]={0b11000110,
-						              0b11001100,
-						              0b11011000,
-						              0b11110000,
-						              0b11011000,
-						              0b11001100,
-						              0b11000110,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
+			n = line_len - off;
+			if(n > len)
+				n = len;
+
+			if(stream.columns)
+				ili9225_cursor_track(stream.x + line,
+					stream.y + off, 1, n, pixels, src);
+			else
+				ili9225_cursor_track(stream.x + off,
+					stream.y + line, n, 1, pixels, src);
 		}
-
-        case 'l':
-		case 'L':
+		else
 		{
-			const uint8_t letter_[8]={0b01100000,
-						              0b01100000,
-						              0b01100000,
-						              0b01100000,
-						              0b01100000,
-						              0b01100000,
-						              0b01111110,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
+			const uint8_t lines = len / line_len;
+
+			n = (size_t)lines * line_len;
+			if(stream.columns)
+				ili9225_cursor_track(stream.x + line, stream.y,
+					lines, stream.h, pixels, src);
+			else
+				ili9225_cursor_track(stream.x, stream.y + line,
+					stream.w, lines, pixels, src);
 		}
 
-        case 'm':
-		case 'M':
-		{
-			const uint8_t letter_[8]={0b11000110,
-						              0b11101110,
-						              0b11111110,
-						              0b11010110,
-						              0b11000110,
-						              0b11000110,
-						              0b11000110,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+		if(src != ILI9225_CURSOR_SRC_SOLID)
+			pixels += n;
+		stream.pos += n;
+		len -= n;
+	}
+}
 
-        case 'n':
-		case 'N':
-		{
-			const uint8_t letter_[8]={0b11000110,
-						              0b11100110,
-						              0b11110110,
-						              0b11011110,
-						              0b11001110,
-						              0b11000110,
-						              0b11000110,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+void ili9225_stream_begin(uint8_t x, uint8_t y, uint8_t w, uint8_t h)
+{
+	stream_begin(x, y, w, h, false);
+}
 
-        case 'o':
-		case 'O':
-		{
-			const uint8_t letter_[8]={0b00111100,
-						              0b01100110,
-						              0b01100110,
-						              0b01100110,
-						              0b01100110,
-						              0b01100110,
-						              0b00111100,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+void ili9225_stream_begin_columns(uint8_t x, uint8_t y, uint8_t w, uint8_t h)
+{
+	stream_begin(x, y, w, h, true);
+}
 
-        case 'p':
-		case 'P':
-		{
-			const uint8_t letter_[8]={0b01111100,
-						              0b01100110,
-						              0b01100110,
-						              0b01111100,
-						              0b01100000,
-						              0b01100000,
-						              0b01100000,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+void ili9225_stream_pixels(const uint16_t *pixels, size_t len)
+{
+	assert(len > 0);
+	assert(stream.pos + len <= (uint32_t)stream.w * stream.h);
+
+	/* Only one transfer may be in flight; the previous buffer is free after
+	 * this wait. */
+	dma_channel_wait_for_finish_blocking(dma_line);
+	dma_channel_configure(dma_line, &line_c,
+			      &spi_get_hw(ili9225_cfg.spi)->dr,
+			      pixels, len, true);
+
+	stream_track(pixels, len, stream.columns ?
+		ILI9225_CURSOR_SRC_COLUMNS : ILI9225_CURSOR_SRC_ROWS);
+}
 
-        case 'q':
-		case 'Q':
-		{
-			const uint8_t letter_[8]={0b01111000,
-						              0b11001100,
-						              0b11001100,
-						              0b11001100,
-						              0b11001100,
-						              0b11011100,
-						              0b01111110,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+void ili9225_stream_repeat(uint16_t color, size_t count)
+{
+	assert(count > 0);
+	assert(stream.pos + count <= (uint32_t)stream.w * stream.h);
 
-        case 'r':
-		case 'R':
-		{
-			const uint8_t letter_[8]={0b01111100,
-						              0b01100110,
-						              0b01100110,
-						              0b01111100,
-						              0b01101100,
-						              0b01100110,
-						              0b01100110,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	dma_channel_wait_for_finish_blocking(dma_line);
+	stream.repeat_color = color;
+	dma_channel_configure(dma_line, &repeat_c,
+			      &spi_get_hw(ili9225_cfg.spi)->dr,
+			      &stream.repeat_color, count, true);
 
-        case 's':
-		case 'S':
-		{
-			const uint8_t letter_[8]={0b00111100,
-						              0b01100110,
-						              0b01110000,
-						              0b00111100,
-						              0b00001110,
-						              0b01100110,
-						              0b00111100,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	stream_track(&stream.repeat_color, count, ILI9225_CURSOR_SRC_SOLID);
+}
 
-        case 't':
-		case 'T':
-		{
-			const uint8_t letter_[8]={0b01111110,
-						              0b00011000,
-						              0b00011000,
-						              0b00011000,
-						              0b00011000,
-						              0b00011000,
-						              0b00011000,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+void ili9225_stream_line(const uint16_t *line, size_t len)
+{
+	assert(len > 0 && len % (stream.columns ? stream.h : stream.w) == 0);
+	ili9225_stream_pixels(line, len);
+}
 
-        case 'u':
-		case 'U':
-		{
-			const uint8_t letter_[8]={0b01100110,
-						              0b01100110,
-						              0b01100110,
-						              0b01100110,
-						              0b01100110,
-						              0b01100110,
-						              0b00111100,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+void ili9225_stream_end(void)
+{
+	spi_inst_t *spi = ili9225_cfg.spi;
 
-        case 'v':
-		case 'V':
-		{
-			const uint8_t letter_[8]={0b01100110,
-						              0b01100110,
-						              0b01100110,
-						              0b01100110,
-						              0b00111100,
-						              0b00111100,
-						              0b00011000,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	dma_channel_wait_for_finish_blocking(dma_line);
 
-        case 'w':
-		case 'W':
-		{
-			const uint8_t letter_[8]={0b11000110,
-						              0b11000110,
-						              0b11000110,
-						              0b11010110,
-						              0b11111110,
-						              0b11101110,
-						              0b11000110,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	/* DMA completion only means the last halfword entered the TX FIFO. */
+	while(spi_is_busy(spi))
+		tight_loop_contents();
 
-        case 'x':
-		case 'X':
-		{
-			const uint8_t letter_[8]={0b11000011,
-						              0b01100110,
-						              0b00111100,
-						              0b00011000,
-						              0b00111100,
-						              0b01100110,
-						              0b11000011,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	/* Discard what was clocked in while transmitting. */
+	while(spi_is_readable(spi))
+		(void)spi_get_hw(spi)->dr;
+	spi_get_hw(spi)->icr = SPI_SSPICR_RORIC_BITS;
 
-        case 'y':
-		case 'Y':
-		{
-			const uint8_t letter_[8]={0b11000011,
-						              0b01100110,
-						              0b00111100,
-						              0b00011000,
-						              0b00011000,
-						              0b00011000,
-						              0b00011000,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	ili9225_write_pixels_end();
+}
 
-        case 'z':
-		case 'Z':
-		{
-			const uint8_t letter_[8]={0b11111110,
-						              0b00001100,
-						              0b00011000,
-						              0b00110000,
-						              0b01100000,
-						              0b11000000,
-						              0b11111110,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+#if MK_ILI9225_READ_AVAILABLE
+void ili9225_read_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h,
+	uint16_t *buf)
+{
+	assert(buf != NULL);
 
-        case '-':
-		{
-			const uint8_t letter_[8]={0b00000000,
-						              0b00000000,
-						              0b00000000,
-									  0b01111110,
-						              0b00000000,
-						              0b00000000,
-						              0b00000000,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	dma_channel_wait_for_finish_blocking(dma_tx);
+	set_scan_columns(false);
+	set_rect_window(x, y, w, h);
 
-        case '(':
-		case '[':
-		case '{':
-		{
-			const uint8_t letter_[8]={0b00001100,
-						              0b00011000,
-						              0b00110000,
-									  0b00110000,
-						              0b00110000,
-						              0b00011000,
-						              0b00001100,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	write_register(MK_ILI9225_REG_GRAM_RW);
+	ili9225_set_rs(1);
+	ili9225_set_cs(0);
 
-        case ')':
-		case ']':
-		case '}':
-		{
-			const uint8_t letter_[8]={0b00110000,
-						              0b00011000,
-						              0b00001100,
-									  0b00001100,
-						              0b00001100,
-						              0b00011000,
-						              0b00110000,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	/* The first read after the address is set returns stale data. */
+	(void)ili9225_spi_read16();
 
-		case ',':
-		{
-			const uint8_t letter_[8]={0b00000000,
-						              0b00000000,
-						              0b00000000,
-									  0b00000000,
-						              0b00000000,
-						              0b00011000,
-						              0b00011000,
-						              0b00110000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	for(uint_fast16_t i = 0; i < (uint_fast16_t)w * h; i++)
+		buf[i] = ili9225_spi_read16();
 
-		case '.':
-		{
-			const uint8_t letter_[8]={0b00000000,
-						              0b00000000,
-						              0b00000000,
-									  0b00000000,
-						              0b00000000,
-						              0b00011000,
-						              0b00011000,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	ili9225_set_cs(1);
+}
 
-		case '!':
-		{
-			const uint8_t letter_[8]={0b00011000,
-						              0b00011000,
-						              0b00011000,
-									  0b00011000,
-						              0b00011000,
-						              0b00000000,
-						              0b00011000,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+void ili9225_blend_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h,
+	uint16_t color, uint8_t alpha)
+{
+	/* Both line buffers hold one band of whole rows. */
+	uint16_t *band = &ili9225_line_buf[0][0];
+	const uint32_t fg = ili9225_spread565(color);
+	const uint32_t a = ((uint32_t)alpha + 4) >> 3;
+	uint_fast16_t band_rows;
 
-		case '&':
-		{
-			const uint8_t letter_[8]={0b00111000,
-						              0b01101100,
-						              0b01101000,
-									  0b01110110,
-						              0b11011100,
-						              0b11001110,
-						              0b01111011,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	assert(w > 0 && h > 0);
 
-		case '\'':
-		{
-			const uint8_t letter_[8]={0b00011000,
-						              0b00011000,
-						              0b00110000,
-									  0b00000000,
-						              0b00000000,
-						              0b00000000,
-						              0b00000000,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	/* Up to 440 rows fit when w is 1, more than an 8-bit counter holds. */
+	band_rows = (2 * LINE_MAX_PX) / w;
+	if(band_rows > h)
+		band_rows = h;
 
-		case '0':
-		{
-			const uint8_t letter_[8]={0b00111100,
-						              0b01100110,
-						              0b01101110,
-									  0b01111110,
-						              0b01110110,
-						              0b01100110,
-						              0b00111100,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	for(uint_fast16_t row = 0; row < h; row += band_rows)
+	{
+		const uint_fast16_t rows = h - row < band_rows ?
+			h - row : band_rows;
+		const uint_fast16_t n = (uint_fast16_t)w * rows;
 
-		case '1':
-		{
-			const uint8_t letter_[8]={0b00011000,
-						              0b00111000,
-						              0b01111000,
-									  0b00011000,
-						              0b00011000,
-						              0b00011000,
-						              0b00011000,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+		ili9225_read_rect(x, y + row, w, rows, band);
 
-		case '2':
-		{
-			const uint8_t letter_[8]={0b00111100,
-						              0b01100110,
-						              0b00000110,
-									  0b00001100,
-						              0b00011000,
-						              0b00110000,
-						              0b01111110,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+		for(uint_fast16_t i = 0; i < n; i++)
+			band[i] = ili9225_pack565(ili9225_lerp_spread(
+				ili9225_spread565(band[i]), fg, a));
 
-		case '3':
-		{
-			const uint8_t letter_[8]={0b00111100,
-						              0b01100110,
-						              0b00000110,
-									  0b00011100,
-						              0b00000110,
-						              0b01100110,
-						              0b00111100,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+		ili9225_blit(band, x, y + row, w, rows);
+	}
+}
+#endif
 
-		case '4':
-		{
-			const uint8_t letter_[8]={0b00011100,
-						              0b00111100,
-						              0b01101100,
-									  0b11001100,
-						              0b11111110,
-						              0b00001100,
-						              0b00001100,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+void ili9225_blit_scaled(const uint16_t *src, uint8_t w, uint8_t h,
+	uint8_t x, uint8_t y, uint8_t sx, uint8_t sy)
+{
+	const uint_fast16_t out_w = (uint_fast16_t)w * sx;
+	const uint_fast16_t out_h = (uint_fast16_t)h * sy;
+	uint_fast8_t buf = 0;
 
-		case '5':
-		{
-			const uint8_t letter_[8]={0b01111110,
-						              0b01100000,
-						              0b01111100,
-									  0b00000110,
-						              0b00000110,
-						              0b01100110,
-						              0b00111100,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	assert(src != NULL);
+	assert(sx > 0 && sy > 0);
+	assert(out_w <= LINE_MAX_PX);
+	/* The window height is 8 bits; a taller result would wrap it. */
+	assert(x + out_w <= ili9225_width());
+	assert(y + out_h <= ili9225_height());
 
-		case '6':
-		{
-			const uint8_t letter_[8]={0b00011100,
-						              0b00110000,
-						              0b01100000,
-									  0b01111100,
-						              0b01100110,
-						              0b01100110,
-						              0b00111100,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	ili9225_stream_begin(x, y, out_w, out_h);
 
-		case '7':
-		{
-			const uint8_t letter_[8]={0b01111110,
-						              0b00000110,
-						              0b00000110,
-									  0b00001100,
-						              0b00011000,
-						              0b00011000,
-						              0b00011000,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+	for(uint_fast8_t row = 0; row < h; row++)
+	{
+		const uint16_t *line = src + (size_t)row * w;
 
-		case '8':
+		/* Unscaled rows are sent straight from the source. */
+		if(sx > 1)
 		{
-			const uint8_t letter_[8]={0b00111100,
-						              0b01100110,
-						              0b01100110,
-									  0b00111100,
-						              0b01100110,
-						              0b01100110,
-						              0b00111100,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+			uint16_t *dst = ili9225_line_buf[buf];
+
+			/* Expansion overlaps the transfer of the other buffer. */
+			for(uint_fast8_t i = 0; i < w; i++)
+			{
+				const uint16_t px = line[i];
+				for(uint_fast8_t r = 0; r < sx; r++)
+					*dst++ = px;
+			}
 
-		case '9':
-		{
-			const uint8_t letter_[8]={0b00111100,
-						              0b01100110,
-						              0b01100110,
-									  0b00111110,
-						              0b00000110,
-						              0b00001100,
-						              0b00111000,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
+			line = ili9225_line_buf[buf];
+			buf ^= 1;
 		}
 
-		default:
-		{
-			const uint8_t letter_[8]={0b00000000,
-						              0b00000000,
-						              0b00000000,
-						              0b00000000,
-						              0b00000000,
-						              0b00000000,
-						              0b00000000,
-						              0b00000000};
-			memcpy(letter,letter_,8);
-			break;
-		}
+		/* Vertical repetition resends the same line. */
+		for(uint_fast8_t r = 0; r < sy; r++)
+			ili9225_stream_line(line, out_w);
 	}
 
+	ili9225_stream_end();
+}
+
+void ili9225_get_letter(uint16_t *fbuf,char l,uint16_t color,uint16_t bgcolor) {
+	const uint8_t *letter = ili9225_font8x8_glyph((uint8_t)l);
+	uint8_t row;
+
 	for(uint8_t y=0;y<8;y++) {
 		row=letter[y];
 		for(uint8_t x=0;x<8;x++) {
@@ -1415,13 +1394,41 @@ void ili9225_get_letter(uint16_t *fbuf,char l,uint16_t color,uint16_t bgcolor) {
 }
 
 void ili9225_text(char *s,uint8_t x,uint8_t y,uint16_t color,uint16_t bgcolor) {
-	uint16_t fbuf[8*8];
-	for(uint8_t i=0;i<strlen(s);i++) {
-		ili9225_get_letter(fbuf,s[i],color,bgcolor);
-		ili9225_blit(fbuf,x,y,8,8);
-		x+=8;
-		if(x>27*8) {
-			break;
+	const uint8_t *glyphs[LINE_MAX_PX / 8];
+	const char *p = s;
+	size_t n = 0;
+	uint_fast8_t buf = 0;
+	uint32_t c;
+
+	/* Only whole characters are drawn. */
+	if(x + 8 > ili9225_width())
+		return;
+
+	while(n < (size_t)(ili9225_width() - x) / 8 &&
+		(c = ili9225_utf8_next(&p)) != 0)
+		glyphs[n++] = ili9225_font8x8_glyph(c);
+
+	if(n == 0)
+		return;
+
+	/* One window covers the whole run. Each line holds the same glyph row
+	 * of every character. */
+	ili9225_stream_begin(x, y, n * 8, 8);
+
+	for(uint_fast8_t row = 0; row < 8; row++) {
+		uint16_t *dst = ili9225_line_buf[buf];
+
+		for(size_t i = 0; i < n; i++) {
+			uint8_t bits = glyphs[i][row];
+			for(uint_fast8_t b = 0; b < 8; b++) {
+				*dst++ = (bits & 128) ? color : bgcolor;
+				bits <<= 1;
+			}
 		}
+
+		ili9225_stream_line(ili9225_line_buf[buf], n * 8);
+		buf ^= 1;
 	}
-}
\ No newline at end of file
+
+	ili9225_stream_end();
+}
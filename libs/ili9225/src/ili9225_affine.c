@@ -0,0 +1,98 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#include <assert.h>
+
+#include "hardware/interp.h"
+
+#include "ili9225_affine.h"
+#include "ili9225_line_buf.h"
+
+/**
+ * Configure interp0 for texture addressing. Lane 0 holds u and lane 1 holds v.
+ * Each pop adds the per-pixel step held in the lane bases, and the full result
+ * is the address of the RGB565 texel at (u mod width, v mod height).
+ */
+static void setup_interp(const struct ili9225_texture *tex)
+{
+	const uint frac = ILI9225_AFFINE_FRAC_BITS;
+	interp_config cfg = interp_default_config();
+
+	/* The masks below span bits 1..width_bits and width_bits+1..
+	 * width_bits+height_bits; an empty span would be inverted. */
+	assert(tex->width_bits >= 1 && tex->height_bits >= 1);
+
+	/* u as a byte offset within the row. */
+	interp_config_set_add_raw(&cfg, true);
+	interp_config_set_shift(&cfg, frac - 1);
+	interp_config_set_mask(&cfg, 1, tex->width_bits);
+	interp_set_config(interp0, 0, &cfg);
+
+	/* v as a byte offset of the row. */
+	interp_config_set_shift(&cfg, frac - 1 - tex->width_bits);
+	interp_config_set_mask(&cfg, tex->width_bits + 1,
+		tex->width_bits + tex->height_bits);
+	interp_set_config(interp0, 1, &cfg);
+
+	interp_set_base(interp0, 2, (uintptr_t)tex->pixels);
+}
+
+static void render_line(uint16_t *dst, const struct ili9225_affine *m,
+	uint8_t j, uint_fast8_t w)
+{
+	interp_set_accumulator(interp0, 0, (uint32_t)m->b * j + (uint32_t)m->c);
+	interp_set_accumulator(interp0, 1, (uint32_t)m->e * j + (uint32_t)m->f);
+	interp_set_base(interp0, 0, (uint32_t)m->a);
+	interp_set_base(interp0, 1, (uint32_t)m->d);
+
+	for(uint_fast8_t i = 0; i < w; i++)
+		dst[i] = *(const uint16_t *)interp_pop_full_result(interp0);
+}
+
+void ili9225_draw_affine(const struct ili9225_texture *tex,
+	const struct ili9225_affine *m, uint8_t x, uint8_t y, uint8_t w,
+	uint8_t h, ili9225_affine_line_cb_t line_cb, void *user)
+{
+	struct ili9225_affine cur = *m;
+	interp_hw_save_t saved;
+	uint_fast8_t buf = 0;
+
+	assert(tex != NULL && tex->pixels != NULL);
+	assert(tex->width_bits < ILI9225_AFFINE_FRAC_BITS);
+	assert(tex->width_bits + tex->height_bits < 31);
+	assert(w > 0 && h > 0);
+	assert(x + w <= ili9225_width());
+	assert(y + h <= ili9225_height());
+
+	interp_save(interp0, &saved);
+	setup_interp(tex);
+
+	ili9225_stream_begin(x, y, w, h);
+
+	for(uint_fast8_t j = 0; j < h; j++)
+	{
+		if(line_cb != NULL)
+			line_cb(j, &cur, user);
+
+		/* The next line is rendered while this one is sent. */
+		render_line(ili9225_line_buf[buf], &cur, j, w);
+		ili9225_stream_line(ili9225_line_buf[buf], w);
+		buf ^= 1;
+	}
+
+	ili9225_stream_end();
+	interp_restore(interp0, &saved);
+}
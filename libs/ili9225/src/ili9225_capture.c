@@ -0,0 +1,198 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#include <assert.h>
+
+#include "pico/stdio.h"
+#include "pico/time.h"
+
+#include "ili9225_capture.h"
+#include "ili9225_line_buf.h"
+
+#if MK_ILI9225_READ_AVAILABLE
+
+/* Each band is read into both line buffers at once. */
+static_assert(ILI9225_CAPTURE_BAND_ROWS >= 1 &&
+	ILI9225_CAPTURE_BAND_ROWS <= 2,
+	"ILI9225_CAPTURE_BAND_ROWS must be 1 or 2");
+
+/* Longest literal or run in one packet. */
+#define PACKET_MAX_PX	128
+
+struct encoder {
+	ili9225_capture_write_t write;
+	void *user;
+	uint32_t bytes;
+
+	uint16_t lit[PACKET_MAX_PX];
+	uint_fast8_t lit_len;
+	uint16_t run_px;
+	uint_fast8_t run_len;
+
+	uint8_t out[64];
+	uint_fast8_t out_len;
+};
+
+static void out_flush(struct encoder *e)
+{
+	if(e->out_len == 0)
+		return;
+
+	e->write(e->out, e->out_len, e->user);
+	e->bytes += e->out_len;
+	e->out_len = 0;
+}
+
+static void out_byte(struct encoder *e, uint8_t b)
+{
+	if(e->out_len == sizeof(e->out))
+		out_flush(e);
+
+	e->out[e->out_len++] = b;
+}
+
+static void out_u16(struct encoder *e, uint16_t v)
+{
+	out_byte(e, v & 0xFF);
+	out_byte(e, v >> 8);
+}
+
+static void out_u32(struct encoder *e, uint32_t v)
+{
+	out_u16(e, v & 0xFFFF);
+	out_u16(e, v >> 16);
+}
+
+static void flush_literal(struct encoder *e)
+{
+	if(e->lit_len == 0)
+		return;
+
+	out_byte(e, e->lit_len - 1);
+	for(uint_fast8_t i = 0; i < e->lit_len; i++)
+		out_u16(e, e->lit[i]);
+
+	e->lit_len = 0;
+}
+
+static void flush_run(struct encoder *e)
+{
+	if(e->run_len == 0)
+		return;
+
+	out_byte(e, 0x80 | (e->run_len - 1));
+	out_u16(e, e->run_px);
+	e->run_len = 0;
+}
+
+static void encode(struct encoder *e, uint16_t px)
+{
+	if(e->run_len > 0)
+	{
+		if(px == e->run_px && e->run_len < PACKET_MAX_PX)
+		{
+			e->run_len++;
+			return;
+		}
+
+		flush_run(e);
+	}
+
+	/* A repeat turns the last literal pixel into a run. */
+	if(e->lit_len > 0 && e->lit[e->lit_len - 1] == px)
+	{
+		e->lit_len--;
+		flush_literal(e);
+		e->run_px = px;
+		e->run_len = 2;
+		return;
+	}
+
+	e->lit[e->lit_len++] = px;
+	if(e->lit_len == PACKET_MAX_PX)
+		flush_literal(e);
+}
+
+void ili9225_capture(ili9225_capture_write_t write, void *user,
+	struct ili9225_capture_stats *stats)
+{
+	static struct encoder e;
+	uint16_t *band = &ili9225_line_buf[0][0];
+	const uint8_t w = ili9225_width();
+	const uint8_t h = ili9225_height();
+	const uint64_t start = time_us_64();
+	uint32_t us;
+
+	assert(write != NULL);
+
+	memset(&e, 0, sizeof(e));
+	e.write = write;
+	e.user = user;
+
+	out_byte(&e, 'I');
+	out_byte(&e, '9');
+	out_byte(&e, 'S');
+	out_byte(&e, 'C');
+	out_byte(&e, ILI9225_CAPTURE_VERSION);
+	out_u16(&e, w);
+	out_u16(&e, h);
+
+	for(uint_fast8_t y = 0; y < h; y += ILI9225_CAPTURE_BAND_ROWS)
+	{
+		const uint_fast8_t rows = h - y < ILI9225_CAPTURE_BAND_ROWS ?
+			h - y : ILI9225_CAPTURE_BAND_ROWS;
+
+		ili9225_read_rect(0, y, w, rows, band);
+
+		for(uint_fast16_t i = 0; i < (uint_fast16_t)w * rows; i++)
+			encode(&e, band[i]);
+	}
+
+	flush_run(&e);
+	flush_literal(&e);
+	us = (uint32_t)(time_us_64() - start);
+
+	out_byte(&e, 'D');
+	out_byte(&e, 'O');
+	out_byte(&e, 'N');
+	out_byte(&e, 'E');
+	out_u32(&e, (uint32_t)w * h);
+	out_u32(&e, us);
+	out_flush(&e);
+
+	if(stats != NULL)
+	{
+		stats->pixels = (uint32_t)w * h;
+		stats->bytes = e.bytes;
+		stats->us = us;
+	}
+}
+
+static void write_stdio(const uint8_t *data, size_t len, void *user)
+{
+	(void)user;
+
+	for(size_t i = 0; i < len; i++)
+		putchar_raw(data[i]);
+}
+
+void ili9225_capture_stdio(struct ili9225_capture_stats *stats)
+{
+	ili9225_capture(write_stdio, NULL, stats);
+	stdio_flush();
+}
+
+#endif
@@ -0,0 +1,158 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#include <assert.h>
+
+#include "ili9225_chart.h"
+#include "ili9225_line_buf.h"
+
+/* The value axis runs along the 176 pixel side of the panel. */
+#define VALUE_PX	SCREEN_SIZE_X
+
+/* Whether time runs along screen x. */
+static bool landscape(void)
+{
+	return ili9225_width() > ili9225_height();
+}
+
+static int_fast16_t value_px(const struct ili9225_chart *c, int32_t v)
+{
+	if(v <= c->min)
+		return 0;
+	if(v >= c->max)
+		return VALUE_PX - 1;
+
+	return (int_fast16_t)(((int64_t)v - c->min) * (VALUE_PX - 1) /
+		((int64_t)c->max - c->min));
+}
+
+static void draw_line(struct ili9225_chart *c)
+{
+	const uint8_t g = ili9225_scroll_row(&c->scroll, 0);
+	const bool land = landscape();
+	uint16_t *line = ili9225_line_buf[0];
+
+	for(uint_fast16_t i = 0; i < VALUE_PX; i++)
+		line[i] = c->bgcolor;
+
+	for(uint_fast8_t t = 0; t < c->traces; t++)
+	{
+		int32_t lo = c->trace[t].lo, hi = c->trace[t].hi;
+		int_fast16_t p0, p1;
+
+		/* Join the previous line so steep changes stay connected. */
+		if(c->trace[t].has_last)
+		{
+			if(c->trace[t].last < lo)
+				lo = c->trace[t].last;
+			if(c->trace[t].last > hi)
+				hi = c->trace[t].last;
+		}
+
+		p0 = value_px(c, lo);
+		p1 = value_px(c, hi);
+
+		/* In landscape, values increase upwards. */
+		if(land)
+		{
+			const int_fast16_t p = p0;
+
+			p0 = VALUE_PX - 1 - p1;
+			p1 = VALUE_PX - 1 - p;
+		}
+
+		for(int_fast16_t p = p0; p <= p1; p++)
+			line[p] = c->trace[t].color;
+	}
+
+	/* The oldest line leaves the chart; its GRAM is reused for the new
+	 * one, which appears at the end once scrolled. */
+	if(land)
+		ili9225_stream_begin_columns(g, 0, 1, VALUE_PX);
+	else
+		ili9225_stream_begin(0, g, VALUE_PX, 1);
+
+	ili9225_stream_line(line, VALUE_PX);
+	ili9225_stream_end();
+
+	ili9225_scroll_by(&c->scroll, 1);
+}
+
+void ili9225_chart_init(struct ili9225_chart *c, uint8_t first, uint8_t last,
+	uint8_t traces, const uint16_t *colors, int32_t min, int32_t max,
+	uint16_t samples_per_px, uint16_t bgcolor)
+{
+	assert(c != NULL && colors != NULL);
+	assert(traces > 0 && traces <= ILI9225_CHART_MAX_TRACES);
+	assert(min < max && samples_per_px > 0);
+
+	c->min = min;
+	c->max = max;
+	c->samples_per_px = samples_per_px;
+	c->traces = traces;
+	c->bgcolor = bgcolor;
+
+	for(uint_fast8_t t = 0; t < traces; t++)
+		c->trace[t].color = colors[t];
+
+	ili9225_scroll_init(&c->scroll, first, last, false);
+	ili9225_chart_clear(c);
+}
+
+void ili9225_chart_add(struct ili9225_chart *c, const int32_t *values)
+{
+	assert(c != NULL && values != NULL);
+
+	for(uint_fast8_t t = 0; t < c->traces; t++)
+	{
+		const int32_t v = values[t];
+
+		if(c->count == 0 || v < c->trace[t].lo)
+			c->trace[t].lo = v;
+		if(c->count == 0 || v > c->trace[t].hi)
+			c->trace[t].hi = v;
+	}
+
+	if(++c->count < c->samples_per_px)
+		return;
+
+	draw_line(c);
+	c->count = 0;
+
+	for(uint_fast8_t t = 0; t < c->traces; t++)
+	{
+		c->trace[t].last = values[t];
+		c->trace[t].has_last = true;
+	}
+}
+
+void ili9225_chart_clear(struct ili9225_chart *c)
+{
+	uint8_t first, n;
+
+	assert(c != NULL);
+	first = c->scroll.top;
+	n = ili9225_scroll_height(&c->scroll);
+
+	if(landscape())
+		ili9225_fill_rect(first, 0, n, VALUE_PX, c->bgcolor);
+	else
+		ili9225_fill_rect(0, first, VALUE_PX, n, c->bgcolor);
+
+	c->count = 0;
+	for(uint_fast8_t t = 0; t < c->traces; t++)
+		c->trace[t].has_last = false;
+}
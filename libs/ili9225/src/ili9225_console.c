@@ -0,0 +1,125 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#include <assert.h>
+
+#include "ili9225_console.h"
+#include "ili9225_utf8.h"
+
+/* Screen row at which GRAM holds the given console line. */
+static uint8_t line_y(const struct ili9225_console *con, uint8_t row)
+{
+	return ili9225_scroll_row(&con->scroll, row * 8);
+}
+
+static void new_line(struct ili9225_console *con)
+{
+	con->col = 0;
+
+	if(con->row + 1 < con->rows)
+	{
+		con->row++;
+		return;
+	}
+
+	/* The top line leaves the screen; its GRAM becomes the new bottom
+	 * line once cleared. */
+	ili9225_fill_rect(0, line_y(con, 0), con->cols * 8, 8, con->bgcolor);
+	ili9225_scroll_by(&con->scroll, 8);
+}
+
+void ili9225_console_init(struct ili9225_console *con, uint16_t color,
+	uint16_t bgcolor)
+{
+	assert(con != NULL);
+	assert(ili9225_width() < ili9225_height());
+
+	con->cols = ili9225_width() / 8;
+	con->rows = ili9225_height() / 8;
+	con->color = color;
+	con->bgcolor = bgcolor;
+	ili9225_console_clear(con);
+}
+
+void ili9225_console_clear(struct ili9225_console *con)
+{
+	assert(con != NULL);
+
+	ili9225_fill_rect(0, 0, ili9225_width(), ili9225_height(),
+		con->bgcolor);
+	con->col = 0;
+	con->row = 0;
+	ili9225_scroll_init(&con->scroll, 0, con->rows * 8 - 1, false);
+}
+
+void ili9225_console_write(struct ili9225_console *con, const char *s)
+{
+	/* Characters collected for the current line. */
+	char run[SCREEN_SIZE_X / 8 * 4 + 1];
+	uint_fast16_t run_len = 0;
+	uint_fast8_t run_col = 0;
+	uint_fast8_t run_chars = 0;
+
+	assert(con != NULL && s != NULL);
+
+	for(;;)
+	{
+		const char *c = s;
+		const uint32_t cp = ili9225_utf8_next(&s);
+
+		if(run_chars != 0 && (cp == 0 || cp == '\n' || cp == '\r' ||
+			con->col == con->cols))
+		{
+			run[run_len] = '\0';
+			ili9225_text(run, run_col * 8, line_y(con, con->row),
+				con->color, con->bgcolor);
+			run_len = 0;
+			run_chars = 0;
+		}
+
+		if(cp == 0)
+			break;
+
+		if(cp == '\n')
+		{
+			new_line(con);
+			continue;
+		}
+		if(cp == '\r')
+		{
+			con->col = 0;
+			continue;
+		}
+
+		if(con->col == con->cols)
+			new_line(con);
+
+		if(run_chars == 0)
+			run_col = con->col;
+
+		while(c < s)
+			run[run_len++] = *c++;
+		run_chars++;
+		con->col++;
+	}
+}
+
+void ili9225_console_putc(struct ili9225_console *con, char c)
+{
+	const char s[2] = { c, '\0' };
+
+	ili9225_console_write(con, s);
+}
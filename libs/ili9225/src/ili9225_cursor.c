@@ -0,0 +1,161 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#include <assert.h>
+
+#include "ili9225_cursor.h"
+
+static struct ili9225_cursor *cursors;
+
+static void write_region(const struct ili9225_cursor *c, const uint16_t *px)
+{
+	/* Written directly, so the overlay does not end up in the cache. */
+	ili9225_set_window(c->x, c->x + c->w - 1, c->y, c->y + c->h - 1);
+	ili9225_write_pixels(px, (uint_fast16_t)c->w * c->h);
+}
+
+static void invalidate(struct ili9225_cursor *c)
+{
+	c->covered_px = 0;
+	memset(c->covered, 0, sizeof(c->covered));
+}
+
+void ili9225_cursor_add(struct ili9225_cursor *c, uint8_t x, uint8_t y,
+	uint8_t w, uint8_t h, uint16_t xor_mask)
+{
+	assert(c != NULL);
+	assert(w > 0 && h > 0);
+	assert((uint_fast16_t)w * h <= ILI9225_CURSOR_MAX_PX);
+
+	c->x = x;
+	c->y = y;
+	c->w = w;
+	c->h = h;
+	c->xor_mask = xor_mask;
+	c->visible = false;
+	invalidate(c);
+
+	c->next = cursors;
+	cursors = c;
+}
+
+void ili9225_cursor_remove(struct ili9225_cursor *c)
+{
+	ili9225_cursor_hide(c);
+
+	for(struct ili9225_cursor **p = &cursors; *p != NULL; p = &(*p)->next)
+	{
+		if(*p == c)
+		{
+			*p = c->next;
+			break;
+		}
+	}
+}
+
+void ili9225_cursor_move(struct ili9225_cursor *c, uint8_t x, uint8_t y)
+{
+	ili9225_cursor_hide(c);
+	c->x = x;
+	c->y = y;
+	invalidate(c);
+}
+
+bool ili9225_cursor_show(struct ili9225_cursor *c)
+{
+	const uint_fast16_t n = (uint_fast16_t)c->w * c->h;
+	uint16_t overlay[ILI9225_CURSOR_MAX_PX];
+
+	if(c->visible)
+		return true;
+
+	if(c->covered_px < n)
+	{
+#if ILI9225_CURSOR_READBACK
+		ili9225_read_rect(c->x, c->y, c->w, c->h, c->saved);
+		memset(c->covered, 0xFF, sizeof(c->covered));
+		c->covered_px = n;
+#else
+		return false;
+#endif
+	}
+
+	for(uint_fast16_t i = 0; i < n; i++)
+		overlay[i] = c->saved[i] ^ c->xor_mask;
+
+	write_region(c, overlay);
+	c->visible = true;
+	return true;
+}
+
+void ili9225_cursor_hide(struct ili9225_cursor *c)
+{
+	if(!c->visible)
+		return;
+
+	/* The whole region is restored, even if some of it was drawn over
+	 * while the cursor was visible. */
+	write_region(c, c->saved);
+	c->visible = false;
+}
+
+bool ili9225_cursor_toggle(struct ili9225_cursor *c)
+{
+	if(c->visible)
+	{
+		ili9225_cursor_hide(c);
+		return false;
+	}
+
+	return ili9225_cursor_show(c);
+}
+
+void ili9225_cursor_track(uint8_t x, uint8_t y, uint8_t w, uint8_t h,
+	const uint16_t *pixels, ili9225_cursor_src_e src)
+{
+	for(struct ili9225_cursor *c = cursors; c != NULL; c = c->next)
+	{
+		/* Intersection of the drawn rectangle and the cursor. */
+		const int_fast16_t x0 = x > c->x ? x : c->x;
+		const int_fast16_t y0 = y > c->y ? y : c->y;
+		const int_fast16_t x1 = (x + w < c->x + c->w) ? x + w : c->x + c->w;
+		const int_fast16_t y1 = (y + h < c->y + c->h) ? y + h : c->y + c->h;
+
+		for(int_fast16_t py = y0; py < y1; py++)
+		{
+			for(int_fast16_t px = x0; px < x1; px++)
+			{
+				const uint_fast16_t i = (py - c->y) * c->w + (px - c->x);
+				uint16_t val;
+
+				if(src == ILI9225_CURSOR_SRC_SOLID)
+					val = pixels[0];
+				else if(src == ILI9225_CURSOR_SRC_ROWS)
+					val = pixels[(py - y) * w + (px - x)];
+				else
+					val = pixels[(px - x) * h + (py - y)];
+
+				c->saved[i] = val;
+
+				if(!(c->covered[i / 8] & (1u << (i % 8))))
+				{
+					c->covered[i / 8] |= 1u << (i % 8);
+					c->covered_px++;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,317 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#include <assert.h>
+#include <string.h>
+
+#include "ili9225_color.h"
+#include "ili9225_font.h"
+#include "ili9225_line_buf.h"
+#include "ili9225_utf8.h"
+
+/* Glyph placed on the line, with the position of its bitmap decoder. */
+struct placed {
+	const struct ili9225_font_glyph *g;
+	int16_t x;
+	const uint8_t *p;
+	uint8_t bit;
+	uint8_t run_left;
+	bool run_val;
+};
+
+/* Colours of every coverage value for one colour pair. */
+struct ramp {
+	uint16_t fg;
+	uint16_t bg;
+	uint8_t levels;
+	uint16_t px[16];
+};
+
+static struct placed placed[ILI9225_FONT_MAX_GLYPHS];
+static struct ramp ramps[ILI9225_FONT_RAMP_CACHE];
+static uint_fast8_t ramp_next;
+
+static uint_fast8_t font_bpp(const struct ili9225_font *font)
+{
+	if(font->flags & ILI9225_FONT_4BPP)
+		return 4;
+	if(font->flags & ILI9225_FONT_2BPP)
+		return 2;
+	return 1;
+}
+
+static const uint16_t *get_ramp(uint16_t fg, uint16_t bg, uint_fast8_t levels)
+{
+	struct ramp *r;
+
+	for(uint_fast8_t i = 0; i < ILI9225_FONT_RAMP_CACHE; i++)
+	{
+		r = &ramps[i];
+		if(r->levels == levels && r->fg == fg && r->bg == bg)
+			return r->px;
+	}
+
+	/* Replace the oldest ramp. */
+	r = &ramps[ramp_next];
+	ramp_next = (ramp_next + 1) % ILI9225_FONT_RAMP_CACHE;
+
+	r->fg = fg;
+	r->bg = bg;
+	r->levels = levels;
+	for(uint_fast8_t i = 0; i < levels; i++)
+	{
+		const uint_fast8_t w = (i * 32 + (levels - 1) / 2) / (levels - 1);
+		r->px[i] = ili9225_blend565(bg, fg, w);
+	}
+
+	return r->px;
+}
+
+uint16_t ili9225_font_glyph_index(const struct ili9225_font *font,
+	uint32_t cp)
+{
+	uint_fast16_t lo = 0, hi = font->range_count;
+
+	while(lo < hi)
+	{
+		const uint_fast16_t mid = (lo + hi) / 2;
+		const struct ili9225_font_range *r = &font->ranges[mid];
+
+		if(cp < r->first)
+			hi = mid;
+		else if(cp - r->first >= r->count)
+			lo = mid + 1;
+		else
+			return r->glyph + (cp - r->first);
+	}
+
+	return font->fallback;
+}
+
+static int_fast8_t kerning(const struct ili9225_font *font, uint16_t left,
+	uint16_t right)
+{
+	const uint32_t key = ((uint32_t)left << 16) | right;
+	uint_fast16_t lo = 0, hi = font->kern_count;
+
+	while(lo < hi)
+	{
+		const uint_fast16_t mid = (lo + hi) / 2;
+		const struct ili9225_font_kern *k = &font->kern[mid];
+		const uint32_t mid_key = ((uint32_t)k->left << 16) | k->right;
+
+		if(mid_key == key)
+			return k->adjust;
+		else if(mid_key < key)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return 0;
+}
+
+static uint_fast8_t next_pixel(const struct ili9225_font *font,
+	struct placed *pl, uint_fast8_t bpp)
+{
+	if(!(font->flags & ILI9225_FONT_RLE))
+	{
+		const uint_fast8_t px =
+			(*pl->p >> (8 - bpp - pl->bit)) & ((1 << bpp) - 1);
+
+		pl->bit += bpp;
+		if(pl->bit == 8)
+		{
+			pl->bit = 0;
+			pl->p++;
+		}
+		return px;
+	}
+
+	if(pl->run_left == 0)
+	{
+		pl->run_val = *pl->p >> 7;
+		pl->run_left = (*pl->p & 0x7F) + 1;
+		pl->p++;
+	}
+
+	pl->run_left--;
+	return pl->run_val;
+}
+
+uint16_t ili9225_font_measure(const struct ili9225_font *font, const char *s)
+{
+	uint16_t w = 0;
+	int_fast32_t prev = -1;
+
+	assert(font != NULL && s != NULL);
+
+	for(uint32_t cp; (cp = ili9225_utf8_next(&s)) != 0;)
+	{
+		const uint16_t gi = ili9225_font_glyph_index(font, cp);
+
+		if(prev >= 0)
+			w += kerning(font, prev, gi);
+
+		w += font->glyphs[gi].advance;
+		prev = gi;
+	}
+
+	return w;
+}
+
+int8_t ili9225_font_kerning(const struct ili9225_font *font, uint16_t left,
+	uint16_t right)
+{
+	assert(font != NULL);
+	return kerning(font, left, right);
+}
+
+/* Place the glyphs of the string from s to end along the line, starting at
+ * the given pen position. Returns the pen position after the last glyph. */
+static int_fast16_t place_glyphs(const struct ili9225_font *font,
+	const char *s, const char *end, int_fast16_t pen, uint_fast8_t bpp,
+	uint_fast16_t *count)
+{
+	uint_fast16_t n = 0;
+	int_fast32_t prev = -1;
+
+	for(uint32_t cp; s < end && n < ILI9225_FONT_MAX_GLYPHS &&
+		(cp = ili9225_utf8_next(&s)) != 0;)
+	{
+		const uint16_t gi = ili9225_font_glyph_index(font, cp);
+		const struct ili9225_font_glyph *g = &font->glyphs[gi];
+		struct placed *pl = &placed[n++];
+
+		if(prev >= 0)
+			pen += kerning(font, prev, gi);
+
+		pl->g = g;
+		pl->x = pen + g->x_offset;
+		pl->p = font->bitmap + g->offset;
+		pl->bit = 0;
+		pl->run_left = 0;
+
+		/* Rows above the line are never drawn. */
+		for(int_fast16_t i = 0; i < -g->y_offset * g->width; i++)
+			(void)next_pixel(font, pl, bpp);
+
+		pen += g->advance;
+		prev = gi;
+	}
+
+	*count = n;
+	return pen;
+}
+
+/* Decode the placed glyphs row by row and send the rows to the open
+ * stream. */
+static void send_rows(const struct ili9225_font *font, uint_fast16_t n,
+	uint_fast16_t w, uint_fast16_t rows, uint_fast8_t bpp,
+	uint16_t color, uint16_t bgcolor)
+{
+	static uint_fast8_t buf;
+	const uint16_t *ramp;
+
+	if(bpp == 1)
+	{
+		static uint16_t mono[2];
+
+		mono[0] = bgcolor;
+		mono[1] = color;
+		ramp = mono;
+	}
+	else
+		ramp = get_ramp(color, bgcolor, 1 << bpp);
+
+	for(int_fast16_t row = 0; row < (int_fast16_t)rows; row++)
+	{
+		uint16_t *dst = ili9225_line_buf[buf];
+
+		for(uint_fast16_t i = 0; i < w; i++)
+			dst[i] = bgcolor;
+
+		for(uint_fast16_t i = 0; i < n; i++)
+		{
+			struct placed *pl = &placed[i];
+			const struct ili9225_font_glyph *g = pl->g;
+
+			if(row < g->y_offset || row >= g->y_offset + g->height)
+				continue;
+
+			for(int_fast16_t c = 0; c < g->width; c++)
+			{
+				const int_fast16_t px = pl->x + c;
+				const uint_fast8_t v = next_pixel(font, pl, bpp);
+
+				if(v != 0 && px >= 0 && px < (int_fast16_t)w)
+					dst[px] = ramp[v];
+			}
+		}
+
+		/* The next row is decoded while this one is sent. */
+		ili9225_stream_line(dst, w);
+		buf ^= 1;
+	}
+}
+
+uint16_t ili9225_font_text(const struct ili9225_font *font, const char *s,
+	uint8_t x, uint8_t y, uint16_t color, uint16_t bgcolor)
+{
+	uint_fast16_t n;
+	int_fast16_t pen;
+	uint_fast16_t w, h;
+	uint_fast8_t bpp;
+
+	assert(font != NULL && s != NULL);
+	bpp = font_bpp(font);
+	assert(bpp == 1 || !(font->flags & ILI9225_FONT_RLE));
+
+	pen = place_glyphs(font, s, s + strlen(s), 0, bpp, &n);
+
+	if(pen <= 0 || x >= ili9225_width() || y >= ili9225_height())
+		return 0;
+
+	w = (uint_fast16_t)pen;
+	if(w > (uint_fast16_t)(ili9225_width() - x))
+		w = ili9225_width() - x;
+
+	h = font->line_height;
+	if(h > (uint_fast16_t)(ili9225_height() - y))
+		h = ili9225_height() - y;
+
+	ili9225_stream_begin(x, y, w, h);
+	send_rows(font, n, w, h, bpp, color, bgcolor);
+	ili9225_stream_end();
+
+	return w;
+}
+
+void ili9225_font_stream_text(const struct ili9225_font *font, const char *s,
+	size_t len, int16_t x, uint8_t w, uint8_t rows, uint16_t color,
+	uint16_t bgcolor)
+{
+	uint_fast16_t n;
+	uint_fast8_t bpp;
+
+	assert(font != NULL && s != NULL);
+	assert(w > 0 && w <= LINE_MAX_PX && rows <= font->line_height);
+	bpp = font_bpp(font);
+	assert(bpp == 1 || !(font->flags & ILI9225_FONT_RLE));
+
+	(void)place_glyphs(font, s, s + len, x, bpp, &n);
+	send_rows(font, n, w, rows, bpp, color, bgcolor);
+}
@@ -0,0 +1,248 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#include "ili9225_font8x8.h"
+
+const uint8_t ili9225_font8x8[ILI9225_FONT8X8_COUNT][8] = {
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x20 space */
+	{ 0x18, 0x18, 0x18, 0x18, 0x18, 0x00, 0x18, 0x00 },	/* 0x21 ! */
+	{ 0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x22 " */
+	{ 0x66, 0x66, 0xFF, 0x66, 0xFF, 0x66, 0x66, 0x00 },	/* 0x23 # */
+	{ 0x18, 0x3E, 0x60, 0x3C, 0x06, 0x7C, 0x18, 0x00 },	/* 0x24 $ */
+	{ 0x62, 0x66, 0x0C, 0x18, 0x30, 0x66, 0x46, 0x00 },	/* 0x25 % */
+	{ 0x38, 0x6C, 0x68, 0x76, 0xDC, 0xCE, 0x7B, 0x00 },	/* 0x26 & */
+	{ 0x18, 0x18, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x27 ' */
+	{ 0x0C, 0x18, 0x30, 0x30, 0x30, 0x18, 0x0C, 0x00 },	/* 0x28 ( */
+	{ 0x30, 0x18, 0x0C, 0x0C, 0x0C, 0x18, 0x30, 0x00 },	/* 0x29 ) */
+	{ 0x00, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x00, 0x00 },	/* 0x2A asterisk */
+	{ 0x00, 0x18, 0x18, 0x7E, 0x18, 0x18, 0x00, 0x00 },	/* 0x2B + */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x30 },	/* 0x2C , */
+	{ 0x00, 0x00, 0x00, 0x7E, 0x00, 0x00, 0x00, 0x00 },	/* 0x2D - */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00 },	/* 0x2E . */
+	{ 0x00, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x00 },	/* 0x2F slash */
+	{ 0x3C, 0x66, 0x6E, 0x7E, 0x76, 0x66, 0x3C, 0x00 },	/* 0x30 0 */
+	{ 0x18, 0x38, 0x78, 0x18, 0x18, 0x18, 0x18, 0x00 },	/* 0x31 1 */
+	{ 0x3C, 0x66, 0x06, 0x0C, 0x18, 0x30, 0x7E, 0x00 },	/* 0x32 2 */
+	{ 0x3C, 0x66, 0x06, 0x1C, 0x06, 0x66, 0x3C, 0x00 },	/* 0x33 3 */
+	{ 0x1C, 0x3C, 0x6C, 0xCC, 0xFE, 0x0C, 0x0C, 0x00 },	/* 0x34 4 */
+	{ 0x7E, 0x60, 0x7C, 0x06, 0x06, 0x66, 0x3C, 0x00 },	/* 0x35 5 */
+	{ 0x1C, 0x30, 0x60, 0x7C, 0x66, 0x66, 0x3C, 0x00 },	/* 0x36 6 */
+	{ 0x7E, 0x06, 0x06, 0x0C, 0x18, 0x18, 0x18, 0x00 },	/* 0x37 7 */
+	{ 0x3C, 0x66, 0x66, 0x3C, 0x66, 0x66, 0x3C, 0x00 },	/* 0x38 8 */
+	{ 0x3C, 0x66, 0x66, 0x3E, 0x06, 0x0C, 0x38, 0x00 },	/* 0x39 9 */
+	{ 0x00, 0x00, 0x18, 0x00, 0x00, 0x18, 0x00, 0x00 },	/* 0x3A : */
+	{ 0x00, 0x00, 0x18, 0x00, 0x00, 0x18, 0x18, 0x30 },	/* 0x3B ; */
+	{ 0x0E, 0x18, 0x30, 0x60, 0x30, 0x18, 0x0E, 0x00 },	/* 0x3C < */
+	{ 0x00, 0x00, 0x7E, 0x00, 0x7E, 0x00, 0x00, 0x00 },	/* 0x3D = */
+	{ 0x70, 0x18, 0x0C, 0x06, 0x0C, 0x18, 0x70, 0x00 },	/* 0x3E > */
+	{ 0x3C, 0x66, 0x06, 0x0C, 0x18, 0x00, 0x18, 0x00 },	/* 0x3F ? */
+	{ 0x3C, 0x66, 0x6E, 0x6E, 0x60, 0x62, 0x3C, 0x00 },	/* 0x40 @ */
+	{ 0x3C, 0x66, 0x66, 0x7E, 0x66, 0x66, 0x66, 0x00 },	/* 0x41 A */
+	{ 0x7C, 0x66, 0x66, 0x7C, 0x66, 0x66, 0x7C, 0x00 },	/* 0x42 B */
+	{ 0x1E, 0x30, 0x60, 0x60, 0x60, 0x30, 0x1E, 0x00 },	/* 0x43 C */
+	{ 0x78, 0x6C, 0x66, 0x66, 0x66, 0x6C, 0x78, 0x00 },	/* 0x44 D */
+	{ 0x7E, 0x60, 0x60, 0x78, 0x60, 0x60, 0x7E, 0x00 },	/* 0x45 E */
+	{ 0x7E, 0x60, 0x60, 0x78, 0x60, 0x60, 0x60, 0x00 },	/* 0x46 F */
+	{ 0x3C, 0x66, 0x60, 0x6E, 0x66, 0x66, 0x3E, 0x00 },	/* 0x47 G */
+	{ 0x66, 0x66, 0x66, 0x7E, 0x66, 0x66, 0x66, 0x00 },	/* 0x48 H */
+	{ 0x3C, 0x18, 0x18, 0x18, 0x18, 0x18, 0x3C, 0x00 },	/* 0x49 I */
+	{ 0x06, 0x06, 0x06, 0x06, 0x06, 0x66, 0x3C, 0x00 },	/* 0x4A J */
+	{ 0xC6, 0xCC, 0xD8, 0xF0, 0xD8, 0xCC, 0xC6, 0x00 },	/* 0x4B K */
+	{ 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x7E, 0x00 },	/* 0x4C L */
+	{ 0xC6, 0xEE, 0xFE, 0xD6, 0xC6, 0xC6, 0xC6, 0x00 },	/* 0x4D M */
+	{ 0xC6, 0xE6, 0xF6, 0xDE, 0xCE, 0xC6, 0xC6, 0x00 },	/* 0x4E N */
+	{ 0x3C, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3C, 0x00 },	/* 0x4F O */
+	{ 0x7C, 0x66, 0x66, 0x7C, 0x60, 0x60, 0x60, 0x00 },	/* 0x50 P */
+	{ 0x78, 0xCC, 0xCC, 0xCC, 0xCC, 0xDC, 0x7E, 0x00 },	/* 0x51 Q */
+	{ 0x7C, 0x66, 0x66, 0x7C, 0x6C, 0x66, 0x66, 0x00 },	/* 0x52 R */
+	{ 0x3C, 0x66, 0x70, 0x3C, 0x0E, 0x66, 0x3C, 0x00 },	/* 0x53 S */
+	{ 0x7E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x00 },	/* 0x54 T */
+	{ 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3C, 0x00 },	/* 0x55 U */
+	{ 0x66, 0x66, 0x66, 0x66, 0x3C, 0x3C, 0x18, 0x00 },	/* 0x56 V */
+	{ 0xC6, 0xC6, 0xC6, 0xD6, 0xFE, 0xEE, 0xC6, 0x00 },	/* 0x57 W */
+	{ 0xC3, 0x66, 0x3C, 0x18, 0x3C, 0x66, 0xC3, 0x00 },	/* 0x58 X */
+	{ 0xC3, 0x66, 0x3C, 0x18, 0x18, 0x18, 0x18, 0x00 },	/* 0x59 Y */
+	{ 0xFE, 0x0C, 0x18, 0x30, 0x60, 0xC0, 0xFE, 0x00 },	/* 0x5A Z */
+	{ 0x3C, 0x30, 0x30, 0x30, 0x30, 0x30, 0x3C, 0x00 },	/* 0x5B [ */
+	{ 0x00, 0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x00 },	/* 0x5C backslash */
+	{ 0x3C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x3C, 0x00 },	/* 0x5D ] */
+	{ 0x18, 0x3C, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x5E ^ */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF },	/* 0x5F _ */
+	{ 0x30, 0x18, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x60 ` */
+	{ 0x00, 0x00, 0x3C, 0x06, 0x3E, 0x66, 0x3E, 0x00 },	/* 0x61 a */
+	{ 0x00, 0x60, 0x60, 0x7C, 0x66, 0x66, 0x7C, 0x00 },	/* 0x62 b */
+	{ 0x00, 0x00, 0x3C, 0x60, 0x60, 0x60, 0x3C, 0x00 },	/* 0x63 c */
+	{ 0x00, 0x06, 0x06, 0x3E, 0x66, 0x66, 0x3E, 0x00 },	/* 0x64 d */
+	{ 0x00, 0x00, 0x3C, 0x66, 0x7E, 0x60, 0x3C, 0x00 },	/* 0x65 e */
+	{ 0x00, 0x0E, 0x18, 0x3E, 0x18, 0x18, 0x18, 0x00 },	/* 0x66 f */
+	{ 0x00, 0x00, 0x3E, 0x66, 0x66, 0x3E, 0x06, 0x7C },	/* 0x67 g */
+	{ 0x00, 0x60, 0x60, 0x7C, 0x66, 0x66, 0x66, 0x00 },	/* 0x68 h */
+	{ 0x00, 0x18, 0x00, 0x38, 0x18, 0x18, 0x3C, 0x00 },	/* 0x69 i */
+	{ 0x00, 0x06, 0x00, 0x06, 0x06, 0x06, 0x06, 0x3C },	/* 0x6A j */
+	{ 0x00, 0x60, 0x60, 0x6C, 0x78, 0x6C, 0x66, 0x00 },	/* 0x6B k */
+	{ 0x00, 0x38, 0x18, 0x18, 0x18, 0x18, 0x3C, 0x00 },	/* 0x6C l */
+	{ 0x00, 0x00, 0x66, 0x7F, 0x7F, 0x6B, 0x63, 0x00 },	/* 0x6D m */
+	{ 0x00, 0x00, 0x7C, 0x66, 0x66, 0x66, 0x66, 0x00 },	/* 0x6E n */
+	{ 0x00, 0x00, 0x3C, 0x66, 0x66, 0x66, 0x3C, 0x00 },	/* 0x6F o */
+	{ 0x00, 0x00, 0x7C, 0x66, 0x66, 0x7C, 0x60, 0x60 },	/* 0x70 p */
+	{ 0x00, 0x00, 0x3E, 0x66, 0x66, 0x3E, 0x06, 0x06 },	/* 0x71 q */
+	{ 0x00, 0x00, 0x7C, 0x66, 0x60, 0x60, 0x60, 0x00 },	/* 0x72 r */
+	{ 0x00, 0x00, 0x3E, 0x60, 0x3C, 0x06, 0x7C, 0x00 },	/* 0x73 s */
+	{ 0x00, 0x18, 0x7E, 0x18, 0x18, 0x18, 0x0E, 0x00 },	/* 0x74 t */
+	{ 0x00, 0x00, 0x66, 0x66, 0x66, 0x66, 0x3E, 0x00 },	/* 0x75 u */
+	{ 0x00, 0x00, 0x66, 0x66, 0x66, 0x3C, 0x18, 0x00 },	/* 0x76 v */
+	{ 0x00, 0x00, 0x63, 0x6B, 0x7F, 0x3E, 0x36, 0x00 },	/* 0x77 w */
+	{ 0x00, 0x00, 0x66, 0x3C, 0x18, 0x3C, 0x66, 0x00 },	/* 0x78 x */
+	{ 0x00, 0x00, 0x66, 0x66, 0x66, 0x3E, 0x0C, 0x78 },	/* 0x79 y */
+	{ 0x00, 0x00, 0x7E, 0x0C, 0x18, 0x30, 0x7E, 0x00 },	/* 0x7A z */
+	{ 0x0E, 0x18, 0x18, 0x70, 0x18, 0x18, 0x0E, 0x00 },	/* 0x7B { */
+	{ 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x00 },	/* 0x7C | */
+	{ 0x70, 0x18, 0x18, 0x0E, 0x18, 0x18, 0x70, 0x00 },	/* 0x7D } */
+	{ 0x00, 0x00, 0x76, 0xDC, 0x00, 0x00, 0x00, 0x00 },	/* 0x7E ~ */
+#if ILI9225_FONT8X8_LATIN1
+	/* Control characters. */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x7F  */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x80 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x81 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x82 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x83 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x84 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x85 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x86 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x87 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x88 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x89 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x8A */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x8B */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x8C */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x8D */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x8E */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x8F */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x90 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x91 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x92 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x93 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x94 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x95 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x96 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x97 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x98 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x99 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x9A */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x9B */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x9C */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x9D */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x9E */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0x9F */
+	/* Latin-1 Supplement. */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0xA0 */
+	{ 0x18, 0x00, 0x18, 0x18, 0x18, 0x18, 0x18, 0x00 },	/* 0xA1 */
+	{ 0x18, 0x3C, 0x66, 0x60, 0x66, 0x3C, 0x18, 0x00 },	/* 0xA2 */
+	{ 0x1C, 0x36, 0x30, 0x7C, 0x30, 0x30, 0x7E, 0x00 },	/* 0xA3 */
+	{ 0x00, 0x66, 0x3C, 0x66, 0x66, 0x3C, 0x66, 0x00 },	/* 0xA4 */
+	{ 0x66, 0x66, 0x3C, 0x7E, 0x18, 0x7E, 0x18, 0x00 },	/* 0xA5 */
+	{ 0x18, 0x18, 0x18, 0x00, 0x18, 0x18, 0x18, 0x00 },	/* 0xA6 */
+	{ 0x3C, 0x60, 0x3C, 0x66, 0x3C, 0x06, 0x3C, 0x00 },	/* 0xA7 */
+	{ 0x66, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0xA8 */
+	{ 0x3C, 0x42, 0x9D, 0xA1, 0xA1, 0x9D, 0x42, 0x3C },	/* 0xA9 */
+	{ 0x3C, 0x06, 0x3E, 0x66, 0x3E, 0x00, 0x7E, 0x00 },	/* 0xAA */
+	{ 0x00, 0x33, 0x66, 0xCC, 0x66, 0x33, 0x00, 0x00 },	/* 0xAB */
+	{ 0x00, 0x00, 0x00, 0x7E, 0x06, 0x06, 0x00, 0x00 },	/* 0xAC */
+	{ 0x00, 0x00, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00 },	/* 0xAD */
+	{ 0x3C, 0x42, 0xB9, 0xA5, 0xB9, 0xA5, 0x42, 0x3C },	/* 0xAE */
+	{ 0x7E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0xAF */
+	{ 0x3C, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0xB0 */
+	{ 0x18, 0x18, 0x7E, 0x18, 0x18, 0x00, 0x7E, 0x00 },	/* 0xB1 */
+	{ 0x38, 0x0C, 0x18, 0x30, 0x3C, 0x00, 0x00, 0x00 },	/* 0xB2 */
+	{ 0x38, 0x0C, 0x18, 0x0C, 0x38, 0x00, 0x00, 0x00 },	/* 0xB3 */
+	{ 0x0C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* 0xB4 */
+	{ 0x00, 0x00, 0x66, 0x66, 0x66, 0x7C, 0x60, 0x60 },	/* 0xB5 */
+	{ 0x3F, 0x7B, 0x7B, 0x3B, 0x1B, 0x1B, 0x1B, 0x00 },	/* 0xB6 */
+	{ 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x00 },	/* 0xB7 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x18 },	/* 0xB8 */
+	{ 0x18, 0x38, 0x18, 0x18, 0x3C, 0x00, 0x00, 0x00 },	/* 0xB9 */
+	{ 0x3C, 0x66, 0x66, 0x3C, 0x00, 0x7E, 0x00, 0x00 },	/* 0xBA */
+	{ 0x00, 0xCC, 0x66, 0x33, 0x66, 0xCC, 0x00, 0x00 },	/* 0xBB */
+	{ 0x42, 0xC4, 0x48, 0x52, 0x26, 0x4A, 0x9F, 0x02 },	/* 0xBC */
+	{ 0x42, 0xC4, 0x48, 0x5C, 0x22, 0x44, 0x88, 0x0E },	/* 0xBD */
+	{ 0xE2, 0x24, 0x68, 0x32, 0xE6, 0x0A, 0x1F, 0x02 },	/* 0xBE */
+	{ 0x18, 0x00, 0x18, 0x30, 0x60, 0x66, 0x3C, 0x00 },	/* 0xBF */
+	{ 0x30, 0x00, 0x3C, 0x66, 0x7E, 0x66, 0x66, 0x66 },	/* 0xC0 */
+	{ 0x0C, 0x00, 0x3C, 0x66, 0x7E, 0x66, 0x66, 0x66 },	/* 0xC1 */
+	{ 0x3C, 0x00, 0x3C, 0x66, 0x7E, 0x66, 0x66, 0x66 },	/* 0xC2 */
+	{ 0x3A, 0x00, 0x3C, 0x66, 0x7E, 0x66, 0x66, 0x66 },	/* 0xC3 */
+	{ 0x66, 0x00, 0x3C, 0x66, 0x7E, 0x66, 0x66, 0x66 },	/* 0xC4 */
+	{ 0x18, 0x00, 0x3C, 0x66, 0x7E, 0x66, 0x66, 0x66 },	/* 0xC5 */
+	{ 0x3F, 0x6C, 0xCC, 0xFF, 0xCC, 0xCC, 0xCF, 0x00 },	/* 0xC6 */
+	{ 0x3C, 0x66, 0x60, 0x60, 0x66, 0x3C, 0x0C, 0x18 },	/* 0xC7 */
+	{ 0x30, 0x00, 0x7E, 0x60, 0x78, 0x60, 0x60, 0x7E },	/* 0xC8 */
+	{ 0x0C, 0x00, 0x7E, 0x60, 0x78, 0x60, 0x60, 0x7E },	/* 0xC9 */
+	{ 0x3C, 0x00, 0x7E, 0x60, 0x78, 0x60, 0x60, 0x7E },	/* 0xCA */
+	{ 0x66, 0x00, 0x7E, 0x60, 0x78, 0x60, 0x60, 0x7E },	/* 0xCB */
+	{ 0x30, 0x00, 0x3C, 0x18, 0x18, 0x18, 0x18, 0x3C },	/* 0xCC */
+	{ 0x0C, 0x00, 0x3C, 0x18, 0x18, 0x18, 0x18, 0x3C },	/* 0xCD */
+	{ 0x3C, 0x00, 0x3C, 0x18, 0x18, 0x18, 0x18, 0x3C },	/* 0xCE */
+	{ 0x66, 0x00, 0x3C, 0x18, 0x18, 0x18, 0x18, 0x3C },	/* 0xCF */
+	{ 0x78, 0x6C, 0x66, 0xF6, 0x66, 0x6C, 0x78, 0x00 },	/* 0xD0 */
+	{ 0x3A, 0x00, 0xC6, 0xF6, 0xDE, 0xCE, 0xC6, 0xC6 },	/* 0xD1 */
+	{ 0x30, 0x00, 0x3C, 0x66, 0x66, 0x66, 0x66, 0x3C },	/* 0xD2 */
+	{ 0x0C, 0x00, 0x3C, 0x66, 0x66, 0x66, 0x66, 0x3C },	/* 0xD3 */
+	{ 0x3C, 0x00, 0x3C, 0x66, 0x66, 0x66, 0x66, 0x3C },	/* 0xD4 */
+	{ 0x3A, 0x00, 0x3C, 0x66, 0x66, 0x66, 0x66, 0x3C },	/* 0xD5 */
+	{ 0x66, 0x00, 0x3C, 0x66, 0x66, 0x66, 0x66, 0x3C },	/* 0xD6 */
+	{ 0x00, 0x66, 0x3C, 0x18, 0x3C, 0x66, 0x00, 0x00 },	/* 0xD7 */
+	{ 0x3D, 0x66, 0x6E, 0x7E, 0x76, 0x66, 0xBC, 0x00 },	/* 0xD8 */
+	{ 0x30, 0x00, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3C },	/* 0xD9 */
+	{ 0x0C, 0x00, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3C },	/* 0xDA */
+	{ 0x3C, 0x00, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3C },	/* 0xDB */
+	{ 0x66, 0x00, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3C },	/* 0xDC */
+	{ 0x0C, 0x00, 0xC3, 0x3C, 0x18, 0x18, 0x18, 0x18 },	/* 0xDD */
+	{ 0x60, 0x7C, 0x66, 0x66, 0x7C, 0x60, 0x60, 0x00 },	/* 0xDE */
+	{ 0x3C, 0x66, 0x66, 0x6C, 0x66, 0x66, 0x6C, 0x60 },	/* 0xDF */
+	{ 0x30, 0x18, 0x3C, 0x06, 0x3E, 0x66, 0x3E, 0x00 },	/* 0xE0 */
+	{ 0x0C, 0x18, 0x3C, 0x06, 0x3E, 0x66, 0x3E, 0x00 },	/* 0xE1 */
+	{ 0x18, 0x66, 0x3C, 0x06, 0x3E, 0x66, 0x3E, 0x00 },	/* 0xE2 */
+	{ 0x76, 0xDC, 0x3C, 0x06, 0x3E, 0x66, 0x3E, 0x00 },	/* 0xE3 */
+	{ 0x66, 0x00, 0x3C, 0x06, 0x3E, 0x66, 0x3E, 0x00 },	/* 0xE4 */
+	{ 0x18, 0x18, 0x3C, 0x06, 0x3E, 0x66, 0x3E, 0x00 },	/* 0xE5 */
+	{ 0x00, 0x00, 0x7E, 0x1B, 0x7F, 0xD8, 0x7E, 0x00 },	/* 0xE6 */
+	{ 0x00, 0x00, 0x3C, 0x60, 0x60, 0x3C, 0x0C, 0x18 },	/* 0xE7 */
+	{ 0x30, 0x18, 0x3C, 0x66, 0x7E, 0x60, 0x3C, 0x00 },	/* 0xE8 */
+	{ 0x0C, 0x18, 0x3C, 0x66, 0x7E, 0x60, 0x3C, 0x00 },	/* 0xE9 */
+	{ 0x18, 0x66, 0x3C, 0x66, 0x7E, 0x60, 0x3C, 0x00 },	/* 0xEA */
+	{ 0x66, 0x00, 0x3C, 0x66, 0x7E, 0x60, 0x3C, 0x00 },	/* 0xEB */
+	{ 0x30, 0x18, 0x00, 0x38, 0x18, 0x18, 0x3C, 0x00 },	/* 0xEC */
+	{ 0x0C, 0x18, 0x00, 0x38, 0x18, 0x18, 0x3C, 0x00 },	/* 0xED */
+	{ 0x18, 0x66, 0x00, 0x38, 0x18, 0x18, 0x3C, 0x00 },	/* 0xEE */
+	{ 0x66, 0x00, 0x00, 0x38, 0x18, 0x18, 0x3C, 0x00 },	/* 0xEF */
+	{ 0x6C, 0x38, 0x6C, 0x06, 0x3E, 0x66, 0x3C, 0x00 },	/* 0xF0 */
+	{ 0x76, 0xDC, 0x7C, 0x66, 0x66, 0x66, 0x66, 0x00 },	/* 0xF1 */
+	{ 0x30, 0x18, 0x3C, 0x66, 0x66, 0x66, 0x3C, 0x00 },	/* 0xF2 */
+	{ 0x0C, 0x18, 0x3C, 0x66, 0x66, 0x66, 0x3C, 0x00 },	/* 0xF3 */
+	{ 0x18, 0x66, 0x3C, 0x66, 0x66, 0x66, 0x3C, 0x00 },	/* 0xF4 */
+	{ 0x76, 0xDC, 0x3C, 0x66, 0x66, 0x66, 0x3C, 0x00 },	/* 0xF5 */
+	{ 0x66, 0x00, 0x3C, 0x66, 0x66, 0x66, 0x3C, 0x00 },	/* 0xF6 */
+	{ 0x00, 0x18, 0x00, 0x7E, 0x00, 0x18, 0x00, 0x00 },	/* 0xF7 */
+	{ 0x00, 0x02, 0x3C, 0x6E, 0x7E, 0x76, 0x3C, 0x40 },	/* 0xF8 */
+	{ 0x30, 0x18, 0x66, 0x66, 0x66, 0x66, 0x3E, 0x00 },	/* 0xF9 */
+	{ 0x0C, 0x18, 0x66, 0x66, 0x66, 0x66, 0x3E, 0x00 },	/* 0xFA */
+	{ 0x18, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3E, 0x00 },	/* 0xFB */
+	{ 0x66, 0x00, 0x66, 0x66, 0x66, 0x66, 0x3E, 0x00 },	/* 0xFC */
+	{ 0x0C, 0x18, 0x66, 0x66, 0x66, 0x3E, 0x0C, 0x78 },	/* 0xFD */
+	{ 0x00, 0x60, 0x7C, 0x66, 0x66, 0x7C, 0x60, 0x60 },	/* 0xFE */
+	{ 0x66, 0x00, 0x66, 0x66, 0x66, 0x3E, 0x0C, 0x78 },	/* 0xFF */
+#endif
+};
@@ -0,0 +1,137 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#include <assert.h>
+#include <string.h>
+
+#include "ili9225_font8x8.h"
+#include "ili9225_glyph_cache.h"
+#include "ili9225_utf8.h"
+
+#if ILI9225_GLYPH_CACHE_SIZE < 2
+# error "ILI9225_GLYPH_CACHE_SIZE must be at least 2"
+#endif
+
+struct entry {
+	/* Bitmap in the 8x8 font; NULL if the entry is empty. */
+	const uint8_t *glyph;
+	uint16_t color;
+	uint16_t bgcolor;
+	/* Value of use_count when last used. */
+	uint32_t last_use;
+	uint16_t px[64];
+};
+
+static struct entry entries[ILI9225_GLYPH_CACHE_SIZE];
+static uint32_t use_count;
+static struct ili9225_glyph_cache_stats cache_stats;
+
+static void expand(struct entry *e)
+{
+	uint16_t *dst = e->px;
+
+	for(uint_fast8_t x = 0; x < 8; x++)
+	{
+		const uint_fast8_t mask = 0x80 >> x;
+
+		for(uint_fast8_t y = 0; y < 8; y++)
+			*dst++ = (e->glyph[y] & mask) ? e->color : e->bgcolor;
+	}
+}
+
+const uint16_t *ili9225_glyph_cache_get(uint32_t c, uint16_t color,
+	uint16_t bgcolor)
+{
+	const uint8_t *glyph = ili9225_font8x8_glyph(c);
+	struct entry *victim = &entries[0];
+
+	use_count++;
+
+	for(uint_fast16_t i = 0; i < ILI9225_GLYPH_CACHE_SIZE; i++)
+	{
+		struct entry *e = &entries[i];
+
+		if(e->glyph == glyph && e->color == color &&
+			e->bgcolor == bgcolor)
+		{
+			cache_stats.hits++;
+			e->last_use = use_count;
+			return e->px;
+		}
+
+		if(e->glyph == NULL)
+		{
+			victim = e;
+			break;
+		}
+
+		if(e->last_use < victim->last_use)
+			victim = e;
+	}
+
+	cache_stats.misses++;
+	victim->glyph = glyph;
+	victim->color = color;
+	victim->bgcolor = bgcolor;
+	victim->last_use = use_count;
+	expand(victim);
+
+	return victim->px;
+}
+
+void ili9225_glyph_cache_text(const char *s, uint8_t x, uint8_t y,
+	uint16_t color, uint16_t bgcolor)
+{
+	const char *p = s;
+	size_t n = 0;
+	uint32_t c;
+
+	/* Only whole characters are drawn. */
+	if(x + 8 > ili9225_width())
+		return;
+
+	while(n < (size_t)(ili9225_width() - x) / 8 && ili9225_utf8_next(&p))
+		n++;
+
+	if(n == 0)
+		return;
+
+	ili9225_stream_begin_columns(x, y, n * 8, 8);
+
+	/* The glyph being sent is the most recently used, so looking up the
+	 * next one never replaces it. */
+	for(size_t i = 0; i < n; i++)
+	{
+		c = ili9225_utf8_next(&s);
+		ili9225_stream_line(ili9225_glyph_cache_get(c, color, bgcolor),
+			64);
+	}
+
+	ili9225_stream_end();
+}
+
+void ili9225_glyph_cache_get_stats(struct ili9225_glyph_cache_stats *stats)
+{
+	assert(stats != NULL);
+	*stats = cache_stats;
+}
+
+void ili9225_glyph_cache_reset(void)
+{
+	memset(entries, 0, sizeof(entries));
+	memset(&cache_stats, 0, sizeof(cache_stats));
+	use_count = 0;
+}
@@ -0,0 +1,789 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#include <assert.h>
+
+#include "pico/time.h"
+
+#include "ili9225_jpeg.h"
+
+#define M_SOF0	0xC0
+#define M_SOF1	0xC1
+#define M_DHT	0xC4
+#define M_RST0	0xD0
+#define M_RST7	0xD7
+#define M_SOI	0xD8
+#define M_SOS	0xDA
+#define M_DQT	0xDB
+#define M_DRI	0xDD
+
+#define LOOKUP_BITS	ILI9225_JPEG_LOOKUP_BITS
+
+/* Largest MCU, 16x16 pixels. */
+#define MCU_PX		256
+
+static uint16_t mcu_buf[2][MCU_PX];
+
+/* Position of each coefficient of the zig-zag sequence in the block. */
+static const uint8_t zigzag[64] = {
+	 0,  1,  8, 16,  9,  2,  3, 10,
+	17, 24, 32, 25, 18, 11,  4,  5,
+	12, 19, 26, 33, 40, 48, 41, 34,
+	27, 20, 13,  6,  7, 14, 21, 28,
+	35, 42, 49, 56, 57, 50, 43, 36,
+	29, 22, 15, 23, 30, 37, 44, 51,
+	58, 59, 52, 45, 38, 31, 39, 46,
+	53, 60, 61, 54, 47, 55, 62, 63
+};
+
+static uint16_t be16(const uint8_t *p)
+{
+	return ((uint16_t)p[0] << 8) | p[1];
+}
+
+/**
+ * Step over one marker segment.
+ * \return Start of the segment payload, or NULL at the end of the data.
+ */
+static const uint8_t *next_segment(const uint8_t **p, const uint8_t *end,
+	uint8_t *marker, uint16_t *len)
+{
+	const uint8_t *q = *p;
+
+	/* Markers may be preceded by any number of fill bytes. */
+	while(q + 1 < end && q[0] == 0xFF && q[1] == 0xFF)
+		q++;
+
+	if(q + 4 > end || q[0] != 0xFF)
+		return NULL;
+
+	*marker = q[1];
+	*len = be16(q + 2);
+	if(*len < 2 || q + 2 + *len > end)
+		return NULL;
+
+	*p = q + 2 + *len;
+	*len -= 2;
+	return q + 4;
+}
+
+static bool is_sof(uint8_t m)
+{
+	return m >= 0xC0 && m <= 0xCF && m != M_DHT && m != 0xC8 &&
+		m != 0xCC;
+}
+
+bool ili9225_jpeg_info(const uint8_t *data, size_t size, uint16_t *width,
+	uint16_t *height)
+{
+	const uint8_t *p = data + 2, *end = data + size, *seg;
+	uint8_t marker;
+	uint16_t len;
+
+	assert(data != NULL);
+
+	if(size < 4 || data[0] != 0xFF || data[1] != M_SOI)
+		return false;
+
+	while((seg = next_segment(&p, end, &marker, &len)) != NULL)
+	{
+		if(marker == M_SOS)
+			break;
+
+		if((marker == M_SOF0 || marker == M_SOF1) && len >= 6)
+		{
+			if(height != NULL)
+				*height = be16(seg + 1);
+			if(width != NULL)
+				*width = be16(seg + 3);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static ili9225_jpeg_err_e parse_dqt(struct ili9225_jpeg *j,
+	const uint8_t *seg, uint16_t len)
+{
+	while(len > 0)
+	{
+		const uint8_t pq = seg[0] >> 4, tq = seg[0] & 0x0F;
+
+		if(pq != 0)
+			return ILI9225_JPEG_ERR_UNSUPPORTED;
+		if(tq > 3 || len < 65)
+			return ILI9225_JPEG_ERR_FORMAT;
+
+		for(unsigned i = 0; i < 64; i++)
+			j->quant[tq][i] = seg[1 + i];
+		j->quant_defined |= 1u << tq;
+
+		seg += 65;
+		len -= 65;
+	}
+
+	return ILI9225_JPEG_OK;
+}
+
+static ili9225_jpeg_err_e parse_dht(struct ili9225_jpeg *j,
+	const uint8_t *seg, uint16_t len)
+{
+	while(len > 0)
+	{
+		const uint8_t tc = seg[0] >> 4, th = seg[0] & 0x0F;
+		struct ili9225_jpeg_huff *h;
+		const uint8_t *counts = seg + 1;
+		unsigned total = 0, k = 0;
+		int32_t code = 0;
+
+		if(tc > 1 || th > 1 || len < 17)
+			return ILI9225_JPEG_ERR_FORMAT;
+
+		for(unsigned i = 0; i < 16; i++)
+			total += counts[i];
+		if(total > sizeof(h->vals) || len < 17 + total)
+			return ILI9225_JPEG_ERR_FORMAT;
+
+		h = &j->huff[tc * 2 + th];
+		for(unsigned i = 0; i < total; i++)
+			h->vals[i] = seg[17 + i];
+		for(unsigned i = 0; i < (1u << LOOKUP_BITS); i++)
+			h->lookup[i] = 0;
+
+		/* Codes of each length follow on from the shorter ones. */
+		for(unsigned l = 1; l <= 16; l++)
+		{
+			const unsigned n = counts[l - 1];
+
+			h->valptr[l] = k - code;
+			for(unsigned i = 0; i < n; i++, code++, k++)
+			{
+				const unsigned shift = LOOKUP_BITS - l;
+
+				/* More codes than fit in l bits. */
+				if(code >= (1 << l))
+					return ILI9225_JPEG_ERR_FORMAT;
+
+				if(l > LOOKUP_BITS)
+					continue;
+
+				for(unsigned s = 0; s < (1u << shift); s++)
+					h->lookup[((unsigned)code << shift) | s] =
+						(l << 8) | h->vals[k];
+			}
+
+			h->maxcode[l] = n ? code - 1 : -1;
+			code <<= 1;
+		}
+
+		j->huff_defined |= 1u << (tc * 2 + th);
+		seg += 17 + total;
+		len -= 17 + total;
+	}
+
+	return ILI9225_JPEG_OK;
+}
+
+static ili9225_jpeg_err_e parse_sof(struct ili9225_jpeg *j,
+	const uint8_t *seg, uint16_t len)
+{
+	uint8_t base = 0;
+
+	if(len < 6)
+		return ILI9225_JPEG_ERR_FORMAT;
+	if(seg[0] != 8)
+		return ILI9225_JPEG_ERR_UNSUPPORTED;
+
+	j->height = be16(seg + 1);
+	j->width = be16(seg + 3);
+	j->ncomp = seg[5];
+
+	if(j->width == 0 || j->height == 0)
+		return ILI9225_JPEG_ERR_UNSUPPORTED;
+	if(j->ncomp != 1 && j->ncomp != 3)
+		return ILI9225_JPEG_ERR_UNSUPPORTED;
+	if(len < 6 + 3 * j->ncomp)
+		return ILI9225_JPEG_ERR_FORMAT;
+
+	for(unsigned i = 0; i < j->ncomp; i++)
+	{
+		struct ili9225_jpeg_comp *c = &j->comp[i];
+		const uint8_t *s = seg + 6 + 3 * i;
+
+		c->id = s[0];
+		c->h = s[1] >> 4;
+		c->v = s[1] & 0x0F;
+		c->tq = s[2];
+		c->base = base;
+
+		if(c->tq > 3)
+			return ILI9225_JPEG_ERR_FORMAT;
+		if(c->h < 1 || c->h > 2 || c->v < 1 || c->v > 2)
+			return ILI9225_JPEG_ERR_UNSUPPORTED;
+		/* Chroma must be sampled once per MCU. */
+		if(i > 0 && (c->h != 1 || c->v != 1))
+			return ILI9225_JPEG_ERR_UNSUPPORTED;
+
+		base += c->h * c->v;
+	}
+
+	/* A single component is coded one block at a time. */
+	if(j->ncomp == 1)
+		j->comp[0].h = j->comp[0].v = 1;
+
+	j->hmax = j->comp[0].h;
+	j->vmax = j->comp[0].v;
+	return ILI9225_JPEG_OK;
+}
+
+static ili9225_jpeg_err_e parse_sos(struct ili9225_jpeg *j,
+	const uint8_t *seg, uint16_t len)
+{
+	if(len < 1 || len < 4 + 2 * seg[0])
+		return ILI9225_JPEG_ERR_FORMAT;
+	if(seg[0] != j->ncomp)
+		return ILI9225_JPEG_ERR_UNSUPPORTED;
+
+	for(unsigned i = 0; i < j->ncomp; i++)
+	{
+		const uint8_t *s = seg + 1 + 2 * i;
+		struct ili9225_jpeg_comp *c = &j->comp[i];
+
+		/* Components are expected in frame order. */
+		if(s[0] != c->id)
+			return ILI9225_JPEG_ERR_UNSUPPORTED;
+
+		c->td = s[1] >> 4;
+		c->ta = s[1] & 0x0F;
+		if(c->td > 1 || c->ta > 1)
+			return ILI9225_JPEG_ERR_FORMAT;
+
+		/* Tables must have been defined before the scan. */
+		if(!(j->huff_defined & (1u << c->td)) ||
+			!(j->huff_defined & (1u << (2 + c->ta))) ||
+			!(j->quant_defined & (1u << c->tq)))
+			return ILI9225_JPEG_ERR_FORMAT;
+	}
+
+	return ILI9225_JPEG_OK;
+}
+
+static ili9225_jpeg_err_e parse_headers(struct ili9225_jpeg *j,
+	const uint8_t *data, size_t size)
+{
+	const uint8_t *p = data + 2, *end = data + size, *seg;
+	bool have_frame = false;
+	uint8_t marker;
+	uint16_t len;
+
+	if(size < 4 || data[0] != 0xFF || data[1] != M_SOI)
+		return ILI9225_JPEG_ERR_FORMAT;
+
+	j->restart_interval = 0;
+	j->huff_defined = 0;
+	j->quant_defined = 0;
+
+	while((seg = next_segment(&p, end, &marker, &len)) != NULL)
+	{
+		ili9225_jpeg_err_e err = ILI9225_JPEG_OK;
+
+		if(marker == M_DQT)
+			err = parse_dqt(j, seg, len);
+		else if(marker == M_DHT)
+			err = parse_dht(j, seg, len);
+		else if(marker == M_SOF0 || marker == M_SOF1)
+		{
+			err = parse_sof(j, seg, len);
+			have_frame = true;
+		}
+		else if(is_sof(marker))
+			err = ILI9225_JPEG_ERR_UNSUPPORTED;
+		else if(marker == M_DRI)
+		{
+			if(len < 2)
+				return ILI9225_JPEG_ERR_FORMAT;
+			j->restart_interval = be16(seg);
+		}
+		else if(marker == M_SOS)
+		{
+			if(!have_frame)
+				return ILI9225_JPEG_ERR_FORMAT;
+
+			j->p = p;
+			j->end = end;
+			return parse_sos(j, seg, len);
+		}
+
+		if(err != ILI9225_JPEG_OK)
+			return err;
+	}
+
+	return ILI9225_JPEG_ERR_FORMAT;
+}
+
+/**
+ * Top up the bit buffer to at least 25 bits. Zeros are shifted in once a
+ * marker or the end of the data is reached.
+ */
+static void fill_bits(struct ili9225_jpeg *j)
+{
+	while(j->nbits <= 24)
+	{
+		uint32_t byte = 0;
+
+		if(!j->marker && j->p < j->end)
+		{
+			byte = *j->p;
+			if(byte != 0xFF)
+				j->p++;
+			else if(j->p + 1 < j->end && j->p[1] == 0x00)
+				j->p += 2;
+			else
+			{
+				j->marker = true;
+				byte = 0;
+			}
+		}
+
+		j->bits |= byte << (24 - j->nbits);
+		j->nbits += 8;
+	}
+}
+
+static uint32_t get_bits(struct ili9225_jpeg *j, unsigned n)
+{
+	uint32_t v;
+
+	if(j->nbits < n)
+		fill_bits(j);
+
+	v = j->bits >> (32 - n);
+	j->bits <<= n;
+	j->nbits -= n;
+	return v;
+}
+
+/* Convert n bits of a coefficient to its signed value. */
+static int32_t extend(uint32_t v, unsigned n)
+{
+	if(v < (1u << (n - 1)))
+		return (int32_t)v - (int32_t)(1u << n) + 1;
+	return v;
+}
+
+static int decode_huff(struct ili9225_jpeg *j,
+	const struct ili9225_jpeg_huff *h)
+{
+	uint16_t e;
+
+	if(j->nbits < 16)
+		fill_bits(j);
+
+	e = h->lookup[j->bits >> (32 - LOOKUP_BITS)];
+	if(e != 0)
+	{
+		j->bits <<= e >> 8;
+		j->nbits -= e >> 8;
+		return e & 0xFF;
+	}
+
+	for(unsigned l = LOOKUP_BITS + 1; l <= 16; l++)
+	{
+		const int32_t code = j->bits >> (32 - l);
+
+		if(code <= h->maxcode[l])
+		{
+			j->bits <<= l;
+			j->nbits -= l;
+			return h->vals[h->valptr[l] + code];
+		}
+	}
+
+	j->error = true;
+	return 0;
+}
+
+/**
+ * Coefficients of 8-bit samples lie within +-1024, plus rounding by the
+ * quantiser. Limiting them keeps the inverse DCT from overflowing on corrupt
+ * data.
+ */
+static int16_t clamp_coef(int32_t v)
+{
+	if(v < -2048)
+		return -2048;
+	if(v > 2047)
+		return 2047;
+	return v;
+}
+
+/**
+ * Decode and dequantise one block into j->block.
+ * \return false if only the DC coefficient is set.
+ */
+static bool decode_block(struct ili9225_jpeg *j, struct ili9225_jpeg_comp *c)
+{
+	const uint8_t *q = j->quant[c->tq];
+	const struct ili9225_jpeg_huff *ac = &j->huff[2 + c->ta];
+	int16_t *blk = j->block;
+	bool has_ac = false;
+	unsigned s;
+
+	for(unsigned i = 0; i < 64; i++)
+		blk[i] = 0;
+
+	s = decode_huff(j, &j->huff[c->td]);
+	if(s > 11)
+	{
+		j->error = true;
+		return false;
+	}
+	if(s != 0)
+		c->dc += extend(get_bits(j, s), s);
+	blk[0] = clamp_coef(c->dc * q[0]);
+
+	for(unsigned k = 1; k < 64; k++)
+	{
+		const unsigned rs = decode_huff(j, ac);
+		const unsigned r = rs >> 4;
+
+		s = rs & 0x0F;
+		if(s == 0)
+		{
+			/* End of block, or a run of 16 zeros. */
+			if(r != 15)
+				break;
+			k += 15;
+			continue;
+		}
+
+		k += r;
+		if(k > 63)
+		{
+			j->error = true;
+			break;
+		}
+
+		blk[zigzag[k]] = clamp_coef(extend(get_bits(j, s), s) * q[k]);
+		has_ac = true;
+	}
+
+	return has_ac;
+}
+
+static uint8_t clamp8(int32_t v)
+{
+	if(v < 0)
+		return 0;
+	if(v > 255)
+		return 255;
+	return v;
+}
+
+/* Fixed point constants with 12 fractional bits. */
+#define FIX(x)	((int32_t)((x) * 4096 + 0.5))
+
+/**
+ * One dimensional inverse DCT, as in the islow method of the IJG library.
+ * Leaves the even part in x0..x3 and the odd part in t0..t3; outputs are
+ * x0+t3, x1+t2, x2+t1, x3+t0, x3-t0, x2-t1, x1-t2 and x0-t3.
+ */
+#define IDCT_1D(s0, s1, s2, s3, s4, s5, s6, s7)				\
+	int32_t t0, t1, t2, t3, p1, p2, p3, p4, p5, x0, x1, x2, x3;	\
+	p2 = (s2);							\
+	p3 = (s6);							\
+	p1 = (p2 + p3) * FIX(0.5411961);				\
+	t2 = p1 + p3 * FIX(-1.847759065);				\
+	t3 = p1 + p2 * FIX(0.765366865);				\
+	t0 = ((s0) + (s4)) * 4096;					\
+	t1 = ((s0) - (s4)) * 4096;					\
+	x0 = t0 + t3;							\
+	x3 = t0 - t3;							\
+	x1 = t1 + t2;							\
+	x2 = t1 - t2;							\
+	t0 = (s7);							\
+	t1 = (s5);							\
+	t2 = (s3);							\
+	t3 = (s1);							\
+	p3 = t0 + t2;							\
+	p4 = t1 + t3;							\
+	p1 = t0 + t3;							\
+	p2 = t1 + t2;							\
+	p5 = (p3 + p4) * FIX(1.175875602);				\
+	t0 = t0 * FIX(0.298631336);					\
+	t1 = t1 * FIX(2.053119869);					\
+	t2 = t2 * FIX(3.072711026);					\
+	t3 = t3 * FIX(1.501321110);					\
+	p1 = p5 + p1 * FIX(-0.899976223);				\
+	p2 = p5 + p2 * FIX(-2.562915447);				\
+	p3 = p3 * FIX(-1.961570560);					\
+	p4 = p4 * FIX(-0.390180644);					\
+	t3 += p1 + p4;							\
+	t2 += p2 + p3;							\
+	t1 += p2 + p4;							\
+	t0 += p1 + p3;
+
+/**
+ * Inverse DCT of j->block into 8x8 samples, level shifted to 0..255.
+ * Columns are transformed first, keeping two extra bits of precision.
+ */
+static void idct(const int16_t *in, uint8_t *out)
+{
+	int32_t tmp[64];
+
+	for(unsigned i = 0; i < 8; i++)
+	{
+		const int16_t *d = in + i;
+		int32_t *v = tmp + i;
+
+		if(d[8] == 0 && d[16] == 0 && d[24] == 0 && d[32] == 0 &&
+			d[40] == 0 && d[48] == 0 && d[56] == 0)
+		{
+			const int32_t dc = d[0] * 4;
+			v[0] = v[8] = v[16] = v[24] = dc;
+			v[32] = v[40] = v[48] = v[56] = dc;
+			continue;
+		}
+
+		{
+			IDCT_1D(d[0], d[8], d[16], d[24], d[32], d[40], d[48],
+				d[56])
+			x0 += 512; x1 += 512; x2 += 512; x3 += 512;
+			v[0] = (x0 + t3) >> 10;
+			v[56] = (x0 - t3) >> 10;
+			v[8] = (x1 + t2) >> 10;
+			v[48] = (x1 - t2) >> 10;
+			v[16] = (x2 + t1) >> 10;
+			v[40] = (x2 - t1) >> 10;
+			v[24] = (x3 + t0) >> 10;
+			v[32] = (x3 - t0) >> 10;
+		}
+	}
+
+	for(unsigned i = 0; i < 8; i++)
+	{
+		const int32_t *v = tmp + i * 8;
+		uint8_t *o = out + i * 8;
+
+		/* Remove 12 bits of the constants, 2 extra bits and a factor
+		 * of 8 from the two passes, rounding and adding 128. */
+		IDCT_1D(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7])
+		x0 += 65536 + (128 << 17);
+		x1 += 65536 + (128 << 17);
+		x2 += 65536 + (128 << 17);
+		x3 += 65536 + (128 << 17);
+		o[0] = clamp8((x0 + t3) >> 17);
+		o[7] = clamp8((x0 - t3) >> 17);
+		o[1] = clamp8((x1 + t2) >> 17);
+		o[6] = clamp8((x1 - t2) >> 17);
+		o[2] = clamp8((x2 + t1) >> 17);
+		o[5] = clamp8((x2 - t1) >> 17);
+		o[3] = clamp8((x3 + t0) >> 17);
+		o[4] = clamp8((x3 - t0) >> 17);
+	}
+}
+
+static void fill_block(uint8_t *out, int16_t dc)
+{
+	const uint8_t v = clamp8(((dc + 4) >> 3) + 128);
+
+	for(unsigned i = 0; i < 64; i++)
+		out[i] = v;
+}
+
+static uint16_t to_rgb565(uint8_t r, uint8_t g, uint8_t b)
+{
+	return ((uint16_t)(r >> 3) << 11) | ((uint16_t)(g >> 2) << 5) |
+		(b >> 3);
+}
+
+/**
+ * Convert the visible w by h pixels of the decoded MCU to RGB565, row by row.
+ * Chroma is replicated over the luma samples it covers.
+ */
+static void convert_mcu(const struct ili9225_jpeg *j, uint16_t *out,
+	unsigned w, unsigned h)
+{
+	const uint8_t sx = j->hmax - 1, sy = j->vmax - 1;
+
+	for(unsigned py = 0; py < h; py++)
+	{
+		for(unsigned px = 0; px < w; px++)
+		{
+			const uint8_t *yb = j->samples[(py >> 3) * j->hmax +
+				(px >> 3)];
+			const int32_t yv = yb[(py & 7) * 8 + (px & 7)];
+			unsigned ci;
+			int32_t cb, cr;
+
+			if(j->ncomp == 1)
+			{
+				*out++ = to_rgb565(yv, yv, yv);
+				continue;
+			}
+
+			ci = (py >> sy) * 8 + (px >> sx);
+			cb = j->samples[j->comp[1].base][ci] - 128;
+			cr = j->samples[j->comp[2].base][ci] - 128;
+
+			/* ITU-R BT.601 with 16 fractional bits. */
+			*out++ = to_rgb565(
+				clamp8(yv + ((91881 * cr + 32768) >> 16)),
+				clamp8(yv + ((-22554 * cb - 46802 * cr +
+					32768) >> 16)),
+				clamp8(yv + ((116130 * cb + 32768) >> 16)));
+		}
+	}
+}
+
+/**
+ * Skip to the next restart marker and reset the decoder state after it.
+ */
+static void restart(struct ili9225_jpeg *j)
+{
+	j->bits = 0;
+	j->nbits = 0;
+	j->marker = false;
+
+	while(j->p + 1 < j->end &&
+		!(j->p[0] == 0xFF && j->p[1] >= M_RST0 && j->p[1] <= M_RST7))
+		j->p++;
+	if(j->p + 1 < j->end)
+		j->p += 2;
+
+	for(unsigned i = 0; i < j->ncomp; i++)
+		j->comp[i].dc = 0;
+}
+
+ili9225_jpeg_err_e ili9225_jpeg_draw(struct ili9225_jpeg *j,
+	const uint8_t *data, size_t size, uint8_t x, uint8_t y,
+	struct ili9225_jpeg_stats *stats)
+{
+	const uint64_t start = time_us_64();
+	ili9225_jpeg_err_e err;
+	unsigned mcu_w, mcu_h, cols, rows, vis_w, vis_h;
+	uint32_t mcus = 0;
+	uint64_t bus_us = 0, t;
+	uint16_t todo;
+	unsigned cur = 0;
+	bool started = false;
+
+	assert(j != NULL);
+	assert(data != NULL);
+	assert(x < ili9225_width() && y < ili9225_height());
+
+	err = parse_headers(j, data, size);
+	if(err != ILI9225_JPEG_OK)
+		return err;
+
+	mcu_w = 8 * j->hmax;
+	mcu_h = 8 * j->vmax;
+	cols = (j->width + mcu_w - 1) / mcu_w;
+	rows = (j->height + mcu_h - 1) / mcu_h;
+
+	/* Part of the image that lands on the screen. */
+	vis_w = ili9225_width() - x;
+	if(vis_w > j->width)
+		vis_w = j->width;
+	vis_h = ili9225_height() - y;
+	if(vis_h > j->height)
+		vis_h = j->height;
+
+	j->bits = 0;
+	j->nbits = 0;
+	j->marker = false;
+	j->error = false;
+	for(unsigned i = 0; i < j->ncomp; i++)
+		j->comp[i].dc = 0;
+	todo = j->restart_interval;
+
+	for(unsigned my = 0; my < rows && !j->error; my++)
+	{
+		for(unsigned mx = 0; mx < cols && !j->error; mx++)
+		{
+			const unsigned ox = mx * mcu_w, oy = my * mcu_h;
+			const bool visible = ox < vis_w && oy < vis_h;
+
+			if(j->restart_interval != 0)
+			{
+				if(todo == 0)
+				{
+					restart(j);
+					todo = j->restart_interval;
+				}
+				todo--;
+			}
+
+			for(unsigned ci = 0; ci < j->ncomp; ci++)
+			{
+				struct ili9225_jpeg_comp *c = &j->comp[ci];
+
+				for(unsigned b = 0; b < c->h * c->v; b++)
+				{
+					uint8_t *out = j->samples[c->base + b];
+
+					if(!decode_block(j, c))
+					{
+						if(visible)
+							fill_block(out,
+								j->block[0]);
+					}
+					else if(visible)
+						idct(j->block, out);
+				}
+			}
+
+			mcus++;
+			if(!visible || j->error)
+				continue;
+
+			{
+				const unsigned w = vis_w - ox < mcu_w ?
+					vis_w - ox : mcu_w;
+				const unsigned h = vis_h - oy < mcu_h ?
+					vis_h - oy : mcu_h;
+
+				convert_mcu(j, mcu_buf[cur], w, h);
+
+				/* Sending the previous MCU overlapped with
+				 * decoding this one. */
+				t = time_us_64();
+				if(started)
+					ili9225_stream_end();
+				ili9225_stream_begin(x + ox, y + oy, w, h);
+				ili9225_stream_pixels(mcu_buf[cur], w * h);
+				bus_us += time_us_64() - t;
+				cur ^= 1;
+				started = true;
+			}
+		}
+	}
+
+	t = time_us_64();
+	if(started)
+		ili9225_stream_end();
+	bus_us += time_us_64() - t;
+
+	if(stats != NULL)
+	{
+		stats->mcus = mcus;
+		stats->us = (uint32_t)(time_us_64() - start);
+		stats->bus_us = (uint32_t)bus_us;
+	}
+
+	return j->error ? ILI9225_JPEG_ERR_FORMAT : ILI9225_JPEG_OK;
+}
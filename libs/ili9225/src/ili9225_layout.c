@@ -0,0 +1,195 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#include <assert.h>
+
+#include "ili9225_layout.h"
+#include "ili9225_utf8.h"
+
+/* FNV-1a, to notice text changed in place. */
+static uint32_t hash_text(const char *s)
+{
+	uint32_t h = 2166136261u;
+
+	while(*s != '\0')
+		h = (h ^ (uint8_t)*s++) * 16777619u;
+
+	return h;
+}
+
+static void add_line(struct ili9225_label *l, const char *text,
+	const char *start, const char *end, uint_fast16_t width)
+{
+	l->lines[l->line_count].start = start - text;
+	l->lines[l->line_count].len = end - start;
+	l->lines[l->line_count].width = width;
+	l->line_count++;
+}
+
+void ili9225_label_init(struct ili9225_label *l,
+	const struct ili9225_font *font, uint8_t x, uint8_t y, uint8_t w,
+	uint8_t h, ili9225_align_e align)
+{
+	assert(l != NULL && font != NULL);
+	assert(w > 0 && h >= font->line_height);
+	assert(x + w <= ili9225_width() && y + h <= ili9225_height());
+
+	l->font = font;
+	l->x = x;
+	l->y = y;
+	l->w = w;
+	l->h = h;
+	l->align = align;
+	l->valid = false;
+}
+
+uint8_t ili9225_label_layout(struct ili9225_label *l, const char *text)
+{
+	const struct ili9225_font *font;
+	uint_fast8_t max_lines;
+	const char *p, *start;
+	uint32_t hash;
+
+	assert(l != NULL && text != NULL);
+
+	hash = hash_text(text);
+	if(l->valid && l->text == text && l->hash == hash)
+		return l->line_count;
+
+	font = l->font;
+	max_lines = l->h / font->line_height;
+	if(max_lines > ILI9225_LAYOUT_MAX_LINES)
+		max_lines = ILI9225_LAYOUT_MAX_LINES;
+
+	l->text = text;
+	l->hash = hash;
+	l->valid = true;
+	l->line_count = 0;
+
+	p = start = text;
+	while(*start != '\0' && l->line_count < max_lines)
+	{
+		/* Last space of the line, and the width before it. */
+		const char *brk = NULL;
+		uint_fast16_t brk_width = 0;
+		uint_fast16_t width = 0;
+		int_fast32_t prev = -1;
+		const char *end;
+		uint32_t cp;
+
+		for(;;)
+		{
+			const char *here = p;
+			uint16_t gi;
+			int_fast16_t adv;
+
+			cp = ili9225_utf8_next(&p);
+			if(cp == 0 || cp == '\n')
+			{
+				end = here;
+				break;
+			}
+
+			gi = ili9225_font_glyph_index(font, cp);
+			adv = font->glyphs[gi].advance;
+			if(prev >= 0)
+				adv += ili9225_font_kerning(font, prev, gi);
+
+			if(cp == ' ')
+			{
+				brk = here;
+				brk_width = width;
+			}
+			else if(width + adv > l->w && here != start)
+			{
+				if(brk != NULL)
+				{
+					/* Wrap at the last space. */
+					end = brk;
+					width = brk_width;
+					p = brk + 1;
+				}
+				else
+				{
+					/* The word does not fit on a line. */
+					end = here;
+					p = here;
+				}
+				cp = ' ';
+				break;
+			}
+
+			width += adv;
+			prev = gi;
+		}
+
+		add_line(l, text, start, end, width > l->w ? l->w : width);
+
+		if(cp == 0)
+			break;
+		start = p;
+	}
+
+	return l->line_count;
+}
+
+uint8_t ili9225_label_line_width(const struct ili9225_label *l, uint8_t line)
+{
+	assert(l != NULL && l->valid && line < l->line_count);
+	return l->lines[line].width;
+}
+
+void ili9225_label_draw(struct ili9225_label *l, const char *text,
+	uint16_t color, uint16_t bgcolor)
+{
+	const struct ili9225_font *font;
+	uint_fast16_t y = 0;
+
+	ili9225_label_layout(l, text);
+	font = l->font;
+
+	ili9225_stream_begin(l->x, l->y, l->w, l->h);
+
+	for(uint_fast8_t i = 0; i < l->line_count; i++)
+	{
+		int_fast16_t x = 0;
+
+		if(l->align == ILI9225_ALIGN_CENTER)
+			x = (l->w - l->lines[i].width) / 2;
+		else if(l->align == ILI9225_ALIGN_RIGHT)
+			x = l->w - l->lines[i].width;
+
+		ili9225_font_stream_text(font, text + l->lines[i].start,
+			l->lines[i].len, x, l->w, font->line_height, color,
+			bgcolor);
+		y += font->line_height;
+	}
+
+	/* Clear the rest of the box. */
+	while(y < l->h)
+	{
+		uint_fast8_t rows = l->h - y;
+
+		if(rows > font->line_height)
+			rows = font->line_height;
+
+		ili9225_font_stream_text(font, text, 0, 0, l->w, rows, color,
+			bgcolor);
+		y += rows;
+	}
+
+	ili9225_stream_end();
+}
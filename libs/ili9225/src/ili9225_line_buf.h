@@ -0,0 +1,39 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+/* Internal to the library; not installed with the public headers. */
+
+#ifndef _MK_ILI9225_LINE_BUF_H
+#define _MK_ILI9225_LINE_BUF_H
+
+#include <stdint.h>
+
+#include "ili9225.h"
+
+/* Longest line in any orientation. */
+#define LINE_MAX_PX	SCREEN_SIZE_Y
+
+/**
+ * Pair of line buffers shared by every drawing function that builds pixels
+ * in RAM before streaming them. Fill one while the other is sent with
+ * ili9225_stream_pixels(), which waits for the previous transfer first.
+ * Both are free again once ili9225_stream_end() returns, so a caller must
+ * not call another drawing function between ili9225_stream_begin() and
+ * ili9225_stream_end().
+ */
+extern uint16_t ili9225_line_buf[2][LINE_MAX_PX];
+
+#endif
@@ -0,0 +1,124 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#include <assert.h>
+#include <string.h>
+
+#include "ili9225_glyph_cache.h"
+#include "ili9225_number.h"
+
+void ili9225_format_fixed(char *buf, uint8_t cells, int32_t value,
+	uint8_t decimals)
+{
+	/* Negate in unsigned arithmetic so INT32_MIN does not overflow. */
+	uint32_t v = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+	int_fast16_t i = cells - 1;
+	uint_fast8_t digits = 0;
+	bool point = decimals == 0;
+
+	assert(buf != NULL);
+
+	/* At least one digit before the decimal point. */
+	while(i >= 0 && (v != 0 || digits <= decimals))
+	{
+		if(!point && digits == decimals)
+		{
+			buf[i--] = '.';
+			point = true;
+		}
+		else
+		{
+			buf[i--] = '0' + v % 10;
+			v /= 10;
+			digits++;
+		}
+	}
+
+	if(v != 0 || digits <= decimals || (value < 0 && i < 0))
+	{
+		memset(buf, '#', cells);
+		return;
+	}
+
+	if(value < 0)
+		buf[i--] = '-';
+
+	while(i >= 0)
+		buf[i--] = ' ';
+}
+
+void ili9225_number_init(struct ili9225_number *n, uint8_t x, uint8_t y,
+	uint8_t cells, uint8_t decimals, uint16_t color, uint16_t bgcolor)
+{
+	assert(n != NULL);
+	assert(cells > 0 && cells <= ILI9225_NUMBER_MAX_CELLS);
+	assert(x + cells * 8 <= ili9225_width() && y + 8 <= ili9225_height());
+
+	n->x = x;
+	n->y = y;
+	n->cells = cells;
+	n->decimals = decimals;
+	n->color = color;
+	n->bgcolor = bgcolor;
+	n->valid = false;
+}
+
+uint8_t ili9225_number_set(struct ili9225_number *n, int32_t value)
+{
+	char text[ILI9225_NUMBER_MAX_CELLS];
+	uint_fast8_t drawn = 0;
+	uint_fast8_t i = 0;
+
+	assert(n != NULL);
+
+	ili9225_format_fixed(text, n->cells, value, n->decimals);
+
+	while(i < n->cells)
+	{
+		uint_fast8_t end;
+
+		if(n->valid && text[i] == n->shown[i])
+		{
+			i++;
+			continue;
+		}
+
+		/* Extend the window over the following changed cells. */
+		end = i + 1;
+		while(end < n->cells && (!n->valid || text[end] != n->shown[end]))
+			end++;
+
+		ili9225_stream_begin_columns(n->x + i * 8, n->y, (end - i) * 8,
+			8);
+		for(; i < end; i++)
+		{
+			ili9225_stream_line(ili9225_glyph_cache_get(
+				(uint8_t)text[i], n->color, n->bgcolor), 64);
+			n->shown[i] = text[i];
+			drawn++;
+		}
+		ili9225_stream_end();
+	}
+
+	n->valid = true;
+	return drawn;
+}
+
+void ili9225_number_invalidate(struct ili9225_number *n)
+{
+	assert(n != NULL);
+	n->valid = false;
+}
@@ -0,0 +1,193 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#include <assert.h>
+
+#include "ili9225_line_buf.h"
+#include "ili9225_qoi.h"
+
+#define QOI_HEADER_SIZE	14
+#define QOI_PADDING	8
+
+#define QOI_OP_INDEX	0x00
+#define QOI_OP_DIFF	0x40
+#define QOI_OP_LUMA	0x80
+#define QOI_OP_RUN	0xC0
+#define QOI_OP_RGB	0xFE
+#define QOI_OP_RGBA	0xFF
+#define QOI_MASK_2	0xC0
+
+/* 4x4 Bayer matrix, 0 to 15. */
+static const uint8_t bayer4[4][4] = {
+	{  0,  8,  2, 10 },
+	{ 12,  4, 14,  6 },
+	{  3, 11,  1,  9 },
+	{ 15,  7, 13,  5 }
+};
+
+static uint32_t read_be32(const uint8_t *p)
+{
+	return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+		((uint32_t)p[2] << 8) | p[3];
+}
+
+bool ili9225_qoi_info(const uint8_t *data, size_t size, uint16_t *width,
+	uint16_t *height)
+{
+	uint32_t w, h;
+
+	assert(data != NULL);
+
+	if(size < QOI_HEADER_SIZE + QOI_PADDING ||
+		data[0] != 'q' || data[1] != 'o' ||
+		data[2] != 'i' || data[3] != 'f')
+		return false;
+
+	w = read_be32(data + 4);
+	h = read_be32(data + 8);
+	if(w == 0 || h == 0 || w > UINT16_MAX || h > UINT16_MAX)
+		return false;
+
+	if(width != NULL)
+		*width = w;
+	if(height != NULL)
+		*height = h;
+
+	return true;
+}
+
+static uint16_t to_rgb565(uint8_t r, uint8_t g, uint8_t b)
+{
+	return ((uint16_t)(r >> 3) << 11) | ((uint16_t)(g >> 2) << 5) |
+		(b >> 3);
+}
+
+/**
+ * Add a threshold below one step of the reduced channel before truncating:
+ * up to 7/8 of a step for the 5-bit channels and 3/4 for green.
+ */
+static uint16_t to_rgb565_dither(uint8_t r, uint8_t g, uint8_t b, uint8_t d)
+{
+	const uint_fast16_t d5 = d >> 1, d6 = d >> 2;
+	const uint_fast16_t r2 = r + d5, g2 = g + d6, b2 = b + d5;
+
+	return to_rgb565(r2 > 255 ? 255 : r2, g2 > 255 ? 255 : g2,
+		b2 > 255 ? 255 : b2);
+}
+
+bool ili9225_qoi_blit(const uint8_t *data, size_t size, uint8_t x, uint8_t y,
+	bool dither)
+{
+	/* RGBA colours previously seen, indexed by their hash. */
+	uint32_t index[64] = { 0 };
+	uint8_t r = 0, g = 0, b = 0, a = 255;
+	uint_fast8_t run = 0;
+	const uint8_t *p, *end;
+	uint16_t w, h;
+	unsigned cur = 0;
+	bool ok = true;
+
+	if(!ili9225_qoi_info(data, size, &w, &h))
+		return false;
+
+	if(x + w > ili9225_width() || y + h > ili9225_height())
+		return false;
+
+	p = data + QOI_HEADER_SIZE;
+	end = data + size - QOI_PADDING;
+
+	ili9225_stream_begin(x, y, w, h);
+
+	for(uint_fast16_t row = 0; row < h; row++)
+	{
+		uint16_t *out = ili9225_line_buf[cur];
+		const uint8_t *dith = bayer4[(y + row) & 3];
+
+		for(uint_fast16_t col = 0; col < w; col++)
+		{
+			if(run > 0)
+				run--;
+			else if(p < end)
+			{
+				const uint8_t op = *p++;
+
+				if(op == QOI_OP_RGB)
+				{
+					r = p[0];
+					g = p[1];
+					b = p[2];
+					p += 3;
+				}
+				else if(op == QOI_OP_RGBA)
+				{
+					r = p[0];
+					g = p[1];
+					b = p[2];
+					a = p[3];
+					p += 4;
+				}
+				else if((op & QOI_MASK_2) == QOI_OP_INDEX)
+				{
+					const uint32_t c = index[op];
+					r = c >> 24;
+					g = c >> 16;
+					b = c >> 8;
+					a = c;
+				}
+				else if((op & QOI_MASK_2) == QOI_OP_DIFF)
+				{
+					r += ((op >> 4) & 0x03) - 2;
+					g += ((op >> 2) & 0x03) - 2;
+					b += (op & 0x03) - 2;
+				}
+				else if((op & QOI_MASK_2) == QOI_OP_LUMA)
+				{
+					const uint8_t op2 = *p++;
+					const int_fast8_t vg = (op & 0x3F) - 32;
+					r += vg - 8 + ((op2 >> 4) & 0x0F);
+					g += vg;
+					b += vg - 8 + (op2 & 0x0F);
+				}
+				else
+					run = op & 0x3F;
+
+				index[(r * 3 + g * 5 + b * 7 + a * 11) & 63] =
+					((uint32_t)r << 24) | ((uint32_t)g << 16) |
+					((uint32_t)b << 8) | a;
+			}
+			else
+			{
+				/* Out of data: leave the rest of the row as it
+				 * was decoded and stop after sending it. */
+				ok = false;
+			}
+
+			out[col] = dither ?
+				to_rgb565_dither(r, g, b,
+					dith[(x + col) & 3]) :
+				to_rgb565(r, g, b);
+		}
+
+		ili9225_stream_line(out, w);
+		cur ^= 1;
+
+		if(!ok)
+			break;
+	}
+
+	ili9225_stream_end();
+	return ok;
+}
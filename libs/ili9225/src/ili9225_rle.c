@@ -0,0 +1,126 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#include <assert.h>
+
+#include "ili9225_line_buf.h"
+#include "ili9225_rle.h"
+
+static struct {
+	unsigned cur;
+	size_t fill;
+} dec;
+
+static void flush(void)
+{
+	if(dec.fill == 0)
+		return;
+
+	ili9225_stream_pixels(ili9225_line_buf[dec.cur], dec.fill);
+	dec.cur ^= 1;
+	dec.fill = 0;
+}
+
+/**
+ * Append pixels to the current buffer, sending it whenever it is full.
+ * \param src	Pixels to copy, or NULL to repeat color.
+ */
+static void append(const uint16_t *src, uint16_t color, size_t count)
+{
+	while(count > 0)
+	{
+		size_t n = LINE_MAX_PX - dec.fill;
+		uint16_t *dst = &ili9225_line_buf[dec.cur][dec.fill];
+
+		if(n > count)
+			n = count;
+
+		if(src != NULL)
+		{
+			for(size_t i = 0; i < n; i++)
+				dst[i] = src[i];
+			src += n;
+		}
+		else
+		{
+			for(size_t i = 0; i < n; i++)
+				dst[i] = color;
+		}
+
+		dec.fill += n;
+		count -= n;
+
+		if(dec.fill == LINE_MAX_PX)
+			flush();
+	}
+}
+
+void ili9225_rle_blit(const struct ili9225_rle_image *img, uint8_t x,
+	uint8_t y)
+{
+	const uint16_t *p, *end;
+	uint32_t left;
+
+	assert(img != NULL && img->data != NULL);
+	assert(img->width > 0 && img->height > 0);
+
+	p = img->data;
+	end = p + img->size;
+	left = (uint32_t)img->width * img->height;
+	dec.fill = 0;
+
+	ili9225_stream_begin(x, y, img->width, img->height);
+
+	while(p < end)
+	{
+		const uint16_t tok = *p++;
+		const size_t count = (tok & ILI9225_RLE_COUNT_MASK) + 1;
+
+		assert(count <= left);
+		left -= count;
+
+		if(tok & ILI9225_RLE_RUN)
+		{
+			const uint16_t color = *p++;
+
+			if(count >= ILI9225_RLE_DMA_MIN)
+			{
+				flush();
+				ili9225_stream_repeat(color, count);
+			}
+			else
+				append(NULL, color, count);
+		}
+		else
+		{
+			assert(p + count <= end);
+
+			if(count >= ILI9225_RLE_DMA_MIN)
+			{
+				flush();
+				ili9225_stream_pixels(p, count);
+			}
+			else
+				append(p, 0, count);
+
+			p += count;
+		}
+	}
+
+	flush();
+	assert(left == 0);
+	ili9225_stream_end();
+}
@@ -0,0 +1,138 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#include <assert.h>
+
+#include "hardware/interp.h"
+
+#include "ili9225_color.h"
+#include "ili9225_line_buf.h"
+#include "ili9225_scale.h"
+
+/* Fractional bits of source coordinates. */
+#define FRAC_BITS	16
+#define FRAC_ONE	(1u << FRAC_BITS)
+
+static void resize_line_nearest(uint16_t *dst, const uint16_t *row,
+	uint32_t u, uint32_t du, uint_fast8_t w)
+{
+	interp_set_base(interp0, 2, (uintptr_t)row);
+	interp_set_accumulator(interp0, 0, u);
+
+	for(uint_fast8_t i = 0; i < w; i++)
+		dst[i] = *(const uint16_t *)interp_pop_full_result(interp0);
+}
+
+static void resize_line_bilinear(uint16_t *dst, const uint16_t *row0,
+	const uint16_t *row1, uint32_t wy, uint32_t du, uint16_t src_w,
+	uint_fast8_t w)
+{
+	uint32_t u = 0;
+
+	for(uint_fast8_t i = 0; i < w; i++, u += du)
+	{
+		const uint_fast16_t x0 = u >> FRAC_BITS;
+		const uint_fast16_t x1 = x0 + 1 < src_w ? x0 + 1 : x0;
+		const uint32_t wx = (u >> (FRAC_BITS - 5)) & 0x1F;
+		uint32_t top, bottom;
+
+		top = ili9225_lerp_spread(ili9225_spread565(row0[x0]),
+			ili9225_spread565(row0[x1]), wx);
+		bottom = ili9225_lerp_spread(ili9225_spread565(row1[x0]),
+			ili9225_spread565(row1[x1]), wx);
+		dst[i] = ili9225_pack565(ili9225_lerp_spread(top, bottom, wy));
+	}
+}
+
+void ili9225_blit_resized(const uint16_t *src, uint16_t src_w, uint16_t src_h,
+	uint8_t x, uint8_t y, uint8_t w, uint8_t h,
+	ili9225_scale_filter_e filter)
+{
+	interp_hw_save_t saved;
+	uint32_t du, dv, u0, v;
+	uint_fast8_t buf = 0;
+
+	assert(src != NULL);
+	assert(src_w > 0 && src_h > 0);
+	assert(w > 0 && h > 0);
+	assert(x + w <= ili9225_width());
+	assert(y + h <= ili9225_height());
+
+	if(filter == ILI9225_SCALE_BILINEAR)
+	{
+		/* Align the corner pixels. Rounding up makes the last pixel
+		 * land exactly on the last source pixel; its neighbour is
+		 * clamped to stay in bounds. */
+		du = w > 1 ? (((uint32_t)(src_w - 1) << FRAC_BITS) + w - 2) / (w - 1) : 0;
+		dv = h > 1 ? (((uint32_t)(src_h - 1) << FRAC_BITS) + h - 2) / (h - 1) : 0;
+		u0 = 0;
+		v = 0;
+	}
+	else
+	{
+		/* Sample the centre of each output pixel. */
+		du = ((uint32_t)src_w << FRAC_BITS) / w;
+		dv = ((uint32_t)src_h << FRAC_BITS) / h;
+		u0 = du / 2;
+		v = dv / 2;
+
+		/* Lane 0 steps the source coordinate by du on every pop and
+		 * yields its integer part as a byte offset to a RGB565 pixel.
+		 * Lane 1 is unused. The full result adds the row address in
+		 * base 2. */
+		interp_save(interp0, &saved);
+		{
+			interp_config cfg = interp_default_config();
+			interp_config_set_add_raw(&cfg, true);
+			interp_config_set_shift(&cfg, FRAC_BITS - 1);
+			interp_config_set_mask(&cfg, 1, FRAC_BITS);
+			interp_set_config(interp0, 0, &cfg);
+
+			cfg = interp_default_config();
+			interp_set_config(interp0, 1, &cfg);
+		}
+		interp_set_base(interp0, 0, du);
+		interp_set_base(interp0, 1, 0);
+		interp_set_accumulator(interp0, 1, 0);
+	}
+
+	ili9225_stream_begin(x, y, w, h);
+
+	for(uint_fast8_t j = 0; j < h; j++, v += dv)
+	{
+		const uint_fast16_t y0 = v >> FRAC_BITS;
+		const uint16_t *row0 = src + (size_t)y0 * src_w;
+		uint16_t *dst = ili9225_line_buf[buf];
+
+		if(filter == ILI9225_SCALE_BILINEAR)
+		{
+			const uint16_t *row1 = y0 + 1 < src_h ? row0 + src_w : row0;
+			const uint32_t wy = (v >> (FRAC_BITS - 5)) & 0x1F;
+			resize_line_bilinear(dst, row0, row1, wy, du, src_w, w);
+		}
+		else
+			resize_line_nearest(dst, row0, u0, du, w);
+
+		/* The next line is resampled while this one is sent. */
+		ili9225_stream_line(dst, w);
+		buf ^= 1;
+	}
+
+	ili9225_stream_end();
+
+	if(filter != ILI9225_SCALE_BILINEAR)
+		interp_restore(interp0, &saved);
+}
@@ -0,0 +1,88 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#include <assert.h>
+
+#include "pico/time.h"
+
+#include "ili9225_scroll.h"
+
+static void wait_frame_start(void)
+{
+#if MK_ILI9225_READ_AVAILABLE
+	const uint32_t start = time_us_32();
+	unsigned prev = ili9225_read_driving_line();
+
+	/* The driving line counts up through the frame and wraps when the
+	 * next one starts. */
+	while(time_us_32() - start < ILI9225_SCROLL_VSYNC_TIMEOUT_US)
+	{
+		const unsigned line = ili9225_read_driving_line();
+
+		if(line < prev)
+			break;
+		prev = line;
+	}
+#endif
+}
+
+void ili9225_scroll_init(struct ili9225_scroll *sc, uint8_t top,
+	uint8_t bottom, bool vsync)
+{
+	assert(sc != NULL);
+	assert(top <= bottom && bottom < SCREEN_SIZE_Y);
+
+	sc->top = top;
+	sc->bottom = bottom;
+	sc->offset = 0;
+	sc->vsync = vsync;
+	ili9225_scroll_region(top, bottom, 0);
+}
+
+uint8_t ili9225_scroll_height(const struct ili9225_scroll *sc)
+{
+	assert(sc != NULL);
+	return sc->bottom - sc->top + 1;
+}
+
+uint8_t ili9225_scroll_row(const struct ili9225_scroll *sc, uint8_t row)
+{
+	const uint_fast16_t n = ili9225_scroll_height(sc);
+
+	assert(row < n);
+	return sc->top + (sc->offset + row) % n;
+}
+
+void ili9225_scroll_by(struct ili9225_scroll *sc, int16_t rows)
+{
+	const int_fast16_t n = ili9225_scroll_height(sc);
+	int_fast16_t offset = (sc->offset + rows) % n;
+
+	if(offset < 0)
+		offset += n;
+
+	ili9225_scroll_to(sc, offset);
+}
+
+void ili9225_scroll_to(struct ili9225_scroll *sc, uint8_t offset)
+{
+	assert(offset < ili9225_scroll_height(sc));
+
+	sc->offset = offset;
+	if(sc->vsync)
+		wait_frame_start();
+	ili9225_scroll_region(sc->top, sc->bottom, offset);
+}
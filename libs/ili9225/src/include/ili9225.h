@@ -47,6 +47,13 @@ typedef enum {
 	ILI9225_COLOR_MODE_8COLOR = 1
 } ili9225_color_mode_e;
 
+typedef enum {
+	ILI9225_ROTATION_0 = 0,
+	ILI9225_ROTATION_90 = 90,
+	ILI9225_ROTATION_180 = 180,
+	ILI9225_ROTATION_270 = 270
+} ili9225_rotation_e;
+
 typedef void (*ili9225_dma_finish_callback_t)(void);
 
 /**
@@ -108,9 +115,40 @@ unsigned ili9225_init(const struct ili9225_config*);
 unsigned ili9225_read_driving_line(void);
 #endif
 
+/**
+ * Set the screen orientation. The panel is reprogrammed to do the mapping, so
+ * all coordinates and pixel buffers are in screen order for every rotation.
+ * The window is reset to the full screen and scrolling is stopped.
+ * Rotations 0 and 180 are portrait (176x220), 90 and 270 are landscape
+ * (220x176). The default after ili9225_init() is ILI9225_ROTATION_90.
+ */
+void ili9225_set_rotation(ili9225_rotation_e rotation);
+
+/**
+ * Width of the screen in the current rotation.
+ */
+uint8_t ili9225_width(void);
+
+/**
+ * Height of the screen in the current rotation.
+ */
+uint8_t ili9225_height(void);
+
+/**
+ * Scroll screen rows top to bottom in hardware. Row y of the region then
+ * shows the pixels drawn at row top + (y - top + offset) % (bottom - top + 1).
+ * Drawing functions still address the rows as if unscrolled.
+ * The panel scrolls along its 220 pixel side, so in landscape rotations the
+ * region is a band of columns, top and bottom being its left and right edges,
+ * and it scrolls left.
+ * \param offset Rows scrolled up, less than bottom - top + 1. 0 stops
+ *		scrolling.
+ */
+void ili9225_scroll_region(uint8_t top, uint8_t bottom, uint8_t offset);
+
 /**
  * Set the window that pixel will be written to. Address will loop within the
- * window.
+ * window. Coordinates are in the current rotation and inclusive.
  *
  * \param hor_start
  * \param hor_end
@@ -152,6 +190,76 @@ void ili9225_power_control(uint8_t drive_power, bool sleep);
 
 void ili9225_set_drive_freq(uint16_t f);
 
+/**
+ * Enter a low power mode for idle screens. Only gate lines first to last are
+ * driven, along the same axis as ili9225_scroll_region(), so content outside
+ * the band is not shown. Optionally, only 8 colours are shown, and the panel
+ * is refreshed more slowly. May be called again to change the settings.
+ * \param colour_mode ILI9225_COLOR_MODE_8COLOR shows only the most
+ *		significant bit of each channel.
+ * \param drive_freq Oscillator frequency setting, as for
+ *		ili9225_set_drive_freq(). Lower values reduce power.
+ */
+void ili9225_partial_display(uint8_t first, uint8_t last,
+	ili9225_color_mode_e colour_mode, uint16_t drive_freq);
+
+/**
+ * Drive the whole panel again, restoring the colour mode and oscillator
+ * frequency used before ili9225_partial_display(). Does nothing if the
+ * display is not in partial mode.
+ */
+void ili9225_full_display(void);
+
+/**
+ * Whether ili9225_partial_display() is in effect.
+ */
+bool ili9225_is_partial_display(void);
+
+/**
+ * Current oscillator frequency setting, as passed to ili9225_set_drive_freq().
+ */
+uint16_t ili9225_get_drive_freq(void);
+
+/**
+ * Settings for ili9225_refresh_adaptive().
+ */
+struct ili9225_refresh_config {
+	/* Oscillator frequency setting used while the screen is static. */
+	uint16_t idle_freq;
+	/* SPI clock used while the screen is static, or 0 to keep it. */
+	uint32_t idle_baudrate;
+	/* Time without any drawing after which the idle settings are used. */
+	uint32_t idle_after_ms;
+	/* Number of drawing calls within wake_window_ms that restore the full
+	 * rate. Must be at least 1. */
+	uint16_t wake_updates;
+	uint32_t wake_window_ms;
+};
+
+/**
+ * Lower the panel refresh rate while nothing is drawn. Every drawing call
+ * counts as activity; once the screen has been static for idle_after_ms, the
+ * next ili9225_refresh_poll() switches to the idle settings. A burst of
+ * wake_updates drawing calls within wake_window_ms restores the frequency and
+ * SPI clock in use before then.
+ * ili9225_set_drive_freq() and ili9225_partial_display() leave the idle state
+ * first, and the display is not made idle while in partial mode.
+ * \param cfg Settings, copied. NULL disables adaptive refresh.
+ */
+void ili9225_refresh_adaptive(const struct ili9225_refresh_config *cfg);
+
+/**
+ * Switch to the idle settings if the screen has been static long enough.
+ * Cheap enough to call on every pass of the main loop. Must not be called
+ * from an interrupt or while a stream is open.
+ */
+void ili9225_refresh_poll(void);
+
+/**
+ * Whether adaptive refresh is currently using the idle settings.
+ */
+bool ili9225_refresh_is_idle(void);
+
 void ili9225_set_x(uint8_t x);
 
 /**
@@ -179,6 +287,106 @@ void ili9225_pixel(uint8_t x,uint8_t y,uint16_t color);
  */
 void ili9225_blit(uint16_t *fbuf,uint8_t x,uint8_t y,uint8_t w,uint8_t h);
 
+/**
+ * Copy a framebuffer stored column by column at the given coordinates. GRAM is
+ * updated top to bottom, then left to right, so each column is sent as one
+ * contiguous run.
+ * \param fbuf	Pixels in RGB565 format, one column of h pixels after
+ *		another.
+ */
+void ili9225_blit_columns(const uint16_t *fbuf, uint8_t x, uint8_t y,
+	uint8_t w, uint8_t h);
+
+#if MK_ILI9225_READ_AVAILABLE
+/**
+ * Read a rectangle of pixels back from GRAM.
+ * \param buf	Receives w*h pixels in RGB565 format, row by row.
+ */
+void ili9225_read_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h,
+	uint16_t *buf);
+
+/**
+ * Blend a colour over a rectangle that is already on screen, for example to
+ * draw a translucent popup. The rectangle is read back from GRAM a band of
+ * rows at a time, so no framebuffer is needed.
+ * \param color	RGB565 colour to blend in.
+ * \param alpha	Opacity of color, from 0 (invisible) to 255 (opaque).
+ */
+void ili9225_blend_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h,
+	uint16_t color, uint8_t alpha);
+#endif
+
+/**
+ * Copy only the even or odd screen rows of a framebuffer. Presenting
+ * alternate fields of successive frames halves the data sent per frame, which
+ * suits video where the SPI clock limits the frame rate.
+ * \param fbuf	Pixels in RGB565 format, row by row, all h rows.
+ * \param field	0 to send rows with an even screen y, 1 for odd ones.
+ */
+void ili9225_blit_field(const uint16_t *fbuf, uint8_t x, uint8_t y,
+	uint8_t w, uint8_t h, unsigned field);
+
+/**
+ * Copy a framebuffer enlarged by integer factors. Each source pixel becomes a
+ * block of sx by sy pixels on screen, so the source only needs to be
+ * w*h pixels in size.
+ * \param src	Source pixels in RGB565 format, row by row.
+ * \param w	Width of the source in pixels.
+ * \param h	Height of the source in pixels.
+ * \param x	Left coordinate on screen.
+ * \param y	Top coordinate on screen.
+ * \param sx	Horizontal scale factor. x + w*sx must not pass the right
+ *		edge of the screen.
+ * \param sy	Vertical scale factor. y + h*sy must not pass the bottom
+ *		edge of the screen.
+ */
+void ili9225_blit_scaled(const uint16_t *src, uint8_t w, uint8_t h,
+	uint8_t x, uint8_t y, uint8_t sx, uint8_t sy);
+
+/**
+ * Start streaming pixels into a rectangle. The pixels are then sent line by
+ * line with ili9225_stream_line(), and the burst is closed with
+ * ili9225_stream_end().
+ */
+void ili9225_stream_begin(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+
+/**
+ * Same as ili9225_stream_begin(), but GRAM is filled column by column, so
+ * each call to ili9225_stream_line() sends one column of h pixels. Suits
+ * tall, narrow rectangles and column-major sources.
+ */
+void ili9225_stream_begin_columns(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+
+/**
+ * Send a line of pixels using DMA. Returns as soon as the transfer has started.
+ * The previous line has been sent when this returns, so two buffers may be
+ * used alternately: one is filled while the other is being sent.
+ * \param line	Pixels to send. Must not be modified until the next call to
+ *		ili9225_stream_line() or ili9225_stream_end().
+ * \param len	Number of pixels. Must be one or more full lines of the
+ *		rectangle.
+ */
+void ili9225_stream_line(const uint16_t *line, size_t len);
+
+/**
+ * Same as ili9225_stream_line(), but any number of pixels may be sent,
+ * continuing where the previous call stopped.
+ * \param pixels Pixels to send. Must not be modified until the next transfer
+ *		of the stream or ili9225_stream_end().
+ */
+void ili9225_stream_pixels(const uint16_t *pixels, size_t len);
+
+/**
+ * Send one colour count times using DMA, continuing where the previous call
+ * stopped. Returns as soon as the transfer has started.
+ */
+void ili9225_stream_repeat(uint16_t color, size_t count);
+
+/**
+ * Wait for the last line to be sent and end the burst.
+ */
+void ili9225_stream_end(void);
+
 /**
  * Return an 8x8 framebuffer for the given letter and color / background color
  */
@@ -186,7 +394,7 @@ void ili9225_get_letter(uint16_t *fbuf,char letter,uint16_t color,uint16_t bgcol
 
 /**
  * Write text to the screen using the the coordinates as the upper-left corner of the text.
- * All characters have dimensions of 8x8 pixels.
+ * All characters have dimensions of 8x8 pixels. The string is decoded as UTF-8.
  */
 void ili9225_text(char *s,uint8_t x,uint8_t y,uint16_t color,uint16_t bgcolor);
 
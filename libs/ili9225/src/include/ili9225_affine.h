@@ -0,0 +1,80 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#ifndef _MK_ILI9225_AFFINE_H
+#define _MK_ILI9225_AFFINE_H
+
+#include "ili9225.h"
+
+/* Fractional bits of the matrix coefficients. */
+#define ILI9225_AFFINE_FRAC_BITS	16
+#define ILI9225_AFFINE_ONE		(1l << ILI9225_AFFINE_FRAC_BITS)
+
+/**
+ * Texture sampled by the affine renderer. Both sides must be powers of two
+ * and at least 2 pixels long; coordinates outside the texture wrap around, so
+ * the texture tiles.
+ */
+struct ili9225_texture {
+	const uint16_t *pixels;
+	uint8_t width_bits;
+	uint8_t height_bits;
+};
+
+/**
+ * 2x3 matrix mapping a pixel (i, j) of the output rectangle to a texture
+ * coordinate:
+ *   u = a*i + b*j + c
+ *   v = d*i + e*j + f
+ * All values are signed fixed point with ILI9225_AFFINE_FRAC_BITS fractional
+ * bits.
+ */
+struct ili9225_affine {
+	int32_t a, b, c;
+	int32_t d, e, f;
+};
+
+/**
+ * Called before each output line is rendered. The matrix may be changed to
+ * give every line its own mapping, for example a "mode 7" perspective floor
+ * where the scale depends on the line. It runs while the rectangle is being
+ * streamed, so it must not draw anything itself.
+ * \param line	Line of the output rectangle about to be rendered.
+ * \param m	Matrix used for this and the following lines.
+ * \param user	User pointer passed to ili9225_draw_affine().
+ */
+typedef void (*ili9225_affine_line_cb_t)(uint8_t line,
+	struct ili9225_affine *m, void *user);
+
+/**
+ * Render a texture transformed by an affine matrix into a rectangle. Texture
+ * addresses are computed by interp0 of the calling core, whose state is saved
+ * and restored. Lines are rendered into two line buffers and streamed with
+ * DMA.
+ * \param tex	Texture to sample.
+ * \param m	Initial matrix.
+ * \param x	Left coordinate on screen.
+ * \param y	Top coordinate on screen.
+ * \param w	Width on screen in pixels.
+ * \param h	Height on screen in pixels.
+ * \param line_cb Optional per-line callback. May be NULL.
+ * \param user	User pointer passed to line_cb.
+ */
+void ili9225_draw_affine(const struct ili9225_texture *tex,
+	const struct ili9225_affine *m, uint8_t x, uint8_t y, uint8_t w,
+	uint8_t h, ili9225_affine_line_cb_t line_cb, void *user);
+
+#endif
@@ -0,0 +1,75 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#ifndef _MK_ILI9225_CAPTURE_H
+#define _MK_ILI9225_CAPTURE_H
+
+#include "ili9225.h"
+
+#if MK_ILI9225_READ_AVAILABLE
+
+/* Rows of GRAM read at a time, 1 or 2. The band is read into the line
+ * buffers shared with the drawing functions. */
+#ifndef ILI9225_CAPTURE_BAND_ROWS
+# define ILI9225_CAPTURE_BAND_ROWS 2
+#endif
+
+/**
+ * Screenshot stream format. All integers are little endian.
+ *
+ * Header:	"I9SC", version (1 byte), width (2 bytes), height (2 bytes).
+ * Packets:	A control byte c, followed by either
+ *		- c < 0x80: c+1 literal RGB565 pixels, or
+ *		- c >= 0x80: one RGB565 pixel repeated (c & 0x7F)+1 times.
+ *		Pixels are in screen order, row by row, in the current rotation.
+ * Trailer:	"DONE", pixel count (4 bytes), capture duration in
+ *		microseconds (4 bytes).
+ *
+ * tools/ili9225_screenshot.py decodes the stream to PPM or PNG.
+ */
+#define ILI9225_CAPTURE_VERSION	1
+
+struct ili9225_capture_stats {
+	uint32_t pixels;
+	uint32_t bytes;
+	uint32_t us;
+};
+
+/**
+ * Called with each chunk of the compressed stream. It must not draw on the
+ * screen, as the capture is still reading from it.
+ */
+typedef void (*ili9225_capture_write_t)(const uint8_t *data, size_t len,
+	void *user);
+
+/**
+ * Read the screen back from GRAM a band at a time and emit it as a compressed
+ * stream. No framebuffer is needed.
+ * \param write	Receives the stream.
+ * \param user	Passed to write.
+ * \param stats	Optional. Receives size and duration of the capture.
+ */
+void ili9225_capture(ili9225_capture_write_t write, void *user,
+	struct ili9225_capture_stats *stats);
+
+/**
+ * Capture the screen to stdout, for example over USB CDC with
+ * pico_enable_stdio_usb(). Newline translation is bypassed.
+ */
+void ili9225_capture_stdio(struct ili9225_capture_stats *stats);
+
+#endif
+#endif
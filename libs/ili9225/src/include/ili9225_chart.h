@@ -0,0 +1,81 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#ifndef _MK_ILI9225_CHART_H
+#define _MK_ILI9225_CHART_H
+
+#include "ili9225_scroll.h"
+
+/* Most traces in a chart. */
+#ifndef ILI9225_CHART_MAX_TRACES
+# define ILI9225_CHART_MAX_TRACES 4
+#endif
+
+/**
+ * Strip chart scrolled in hardware. Time runs along the scroll axis of the
+ * panel: left to right in landscape rotations, top to bottom in portrait ones.
+ * Each new pixel of time is drawn as a single line across the chart and then
+ * scrolled into view, so the rest of the chart is never redrawn.
+ *
+ * The chart covers whole gate lines (see ili9225_scroll_region()), which span
+ * the full screen across the time axis.
+ *
+ * The members are private; use the functions below.
+ */
+struct ili9225_chart {
+	struct ili9225_scroll scroll;
+	int32_t min, max;
+	uint16_t samples_per_px;
+	uint16_t count;
+	uint8_t traces;
+	uint16_t bgcolor;
+	struct {
+		uint16_t color;
+		int32_t lo, hi;
+		/* Last sample, joined to the next line. */
+		int32_t last;
+		bool has_last;
+	} trace[ILI9225_CHART_MAX_TRACES];
+};
+
+/**
+ * Set up a chart and clear it.
+ * \param first	First line of the chart along the time axis.
+ * \param last	Last line of the chart along the time axis.
+ * \param traces Number of traces, at most ILI9225_CHART_MAX_TRACES.
+ * \param colors Colour of each trace.
+ * \param min	Value drawn at the bottom (portrait: left) of the chart.
+ * \param max	Value drawn at the top (portrait: right) of the chart.
+ * \param samples_per_px Samples combined into each line. Each line shows
+ *		the range of the samples, so peaks are kept.
+ */
+void ili9225_chart_init(struct ili9225_chart *c, uint8_t first, uint8_t last,
+	uint8_t traces, const uint16_t *colors, int32_t min, int32_t max,
+	uint16_t samples_per_px, uint16_t bgcolor);
+
+/**
+ * Add one sample to every trace. A line is drawn and scrolled in once
+ * samples_per_px samples have been added.
+ * \param values One value per trace. Values outside the range are clamped.
+ */
+void ili9225_chart_add(struct ili9225_chart *c, const int32_t *values);
+
+/**
+ * Clear the chart.
+ */
+void ili9225_chart_clear(struct ili9225_chart *c);
+
+#endif
@@ -0,0 +1,62 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#ifndef _MK_ILI9225_COLOR_H
+#define _MK_ILI9225_COLOR_H
+
+#include <stdint.h>
+
+/* Mask of the channels of a spread RGB565 pixel. */
+#define ILI9225_SPREAD565_MASK	0x07E0F81Fu
+
+/**
+ * Spread a RGB565 pixel over 32 bits, moving green to the upper halfword. The
+ * gaps between channels allow all three to be multiplied by a weight of up to
+ * 32 at once.
+ */
+static inline uint32_t ili9225_spread565(uint16_t px)
+{
+	return (px | ((uint32_t)px << 16)) & ILI9225_SPREAD565_MASK;
+}
+
+/**
+ * Pack a spread pixel back into RGB565.
+ */
+static inline uint16_t ili9225_pack565(uint32_t s)
+{
+	return (uint16_t)(s | (s >> 16));
+}
+
+/**
+ * Interpolate between two spread pixels.
+ * \param w	Weight of b, from 0 to 32.
+ */
+static inline uint32_t ili9225_lerp_spread(uint32_t a, uint32_t b, uint32_t w)
+{
+	return ((a * (32 - w) + b * w) >> 5) & ILI9225_SPREAD565_MASK;
+}
+
+/**
+ * Blend two RGB565 pixels.
+ * \param alpha	Weight of fg, from 0 (only bg) to 32 (only fg).
+ */
+static inline uint16_t ili9225_blend565(uint16_t bg, uint16_t fg, uint8_t alpha)
+{
+	return ili9225_pack565(ili9225_lerp_spread(ili9225_spread565(bg),
+		ili9225_spread565(fg), alpha));
+}
+
+#endif
@@ -0,0 +1,62 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#ifndef _MK_ILI9225_CONSOLE_H
+#define _MK_ILI9225_CONSOLE_H
+
+#include "ili9225_scroll.h"
+
+/**
+ * Text console of 8x8 character cells covering the screen. When the last line
+ * is full, the console scrolls up with the hardware scroll registers and only
+ * the new line is cleared, instead of redrawing the screen.
+ * Requires a portrait rotation, ILI9225_ROTATION_0 or ILI9225_ROTATION_180.
+ *
+ * The members are private; use the functions below.
+ */
+struct ili9225_console {
+	uint8_t cols, rows;
+	/* Cursor position on the screen. */
+	uint8_t col, row;
+	struct ili9225_scroll scroll;
+	uint16_t color;
+	uint16_t bgcolor;
+};
+
+/**
+ * Set up a console and clear the screen.
+ */
+void ili9225_console_init(struct ili9225_console *con, uint16_t color,
+	uint16_t bgcolor);
+
+/**
+ * Clear the console and move the cursor to the top left.
+ */
+void ili9225_console_clear(struct ili9225_console *con);
+
+/**
+ * Write a UTF-8 string at the cursor. '\n' starts a new line and '\r' returns
+ * to the start of the line. Long lines wrap. The characters written to a line
+ * are drawn in one window.
+ */
+void ili9225_console_write(struct ili9225_console *con, const char *s);
+
+/**
+ * Write one ASCII character at the cursor.
+ */
+void ili9225_console_putc(struct ili9225_console *con, char c);
+
+#endif
@@ -0,0 +1,112 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#ifndef _MK_ILI9225_CURSOR_H
+#define _MK_ILI9225_CURSOR_H
+
+#include "ili9225.h"
+
+/* When set, cursors whose region has not been drawn since they were added or
+ * moved read it back from GRAM when shown. */
+#ifndef ILI9225_CURSOR_READBACK
+# define ILI9225_CURSOR_READBACK MK_ILI9225_READ_AVAILABLE
+#endif
+
+/* Largest cursor area in pixels, for example 8x16. */
+#ifndef ILI9225_CURSOR_MAX_PX
+# define ILI9225_CURSOR_MAX_PX 128
+#endif
+
+typedef enum {
+	/* Pixels drawn by ili9225_fill_rect() and ili9225_pixel(). */
+	ILI9225_CURSOR_SRC_SOLID = 0,
+	/* Row-major pixel buffer. */
+	ILI9225_CURSOR_SRC_ROWS = 1,
+	/* Column-major pixel buffer. */
+	ILI9225_CURSOR_SRC_COLUMNS = 2
+} ili9225_cursor_src_e;
+
+/**
+ * A small screen region that can be highlighted and restored without redrawing
+ * it from application state. The pixels under the cursor are cached whenever
+ * they are drawn through this library, so showing or hiding the cursor is a
+ * single window write.
+ *
+ * The members are private; use the functions below.
+ */
+struct ili9225_cursor {
+	struct ili9225_cursor *next;
+	uint8_t x, y, w, h;
+	uint16_t xor_mask;
+	bool visible;
+	uint16_t covered_px;
+	uint8_t covered[(ILI9225_CURSOR_MAX_PX + 7) / 8];
+	uint16_t saved[ILI9225_CURSOR_MAX_PX];
+};
+
+/**
+ * Register a cursor. It starts hidden. Its pixels are cached from then on,
+ * so the region must be drawn at least once before the cursor can be shown.
+ * \param c	Cursor to register. Must stay valid until removed.
+ * \param w	Width of the region. w*h must not exceed ILI9225_CURSOR_MAX_PX.
+ * \param h	Height of the region.
+ * \param xor_mask Value XORed with each pixel to show the cursor. 0xFFFF
+ *		inverts the region.
+ */
+void ili9225_cursor_add(struct ili9225_cursor *c, uint8_t x, uint8_t y,
+	uint8_t w, uint8_t h, uint16_t xor_mask);
+
+/**
+ * Hide and unregister a cursor.
+ */
+void ili9225_cursor_remove(struct ili9225_cursor *c);
+
+/**
+ * Hide the cursor and move it. The cache is invalid until the new region has
+ * been drawn.
+ */
+void ili9225_cursor_move(struct ili9225_cursor *c, uint8_t x, uint8_t y);
+
+/**
+ * Show the cursor.
+ * \return false if the region has not been fully drawn since the cursor was
+ *	added or moved, so the cursor cannot be shown. Always true with
+ *	ILI9225_CURSOR_READBACK.
+ */
+bool ili9225_cursor_show(struct ili9225_cursor *c);
+
+/**
+ * Hide the cursor, restoring the cached pixels.
+ */
+void ili9225_cursor_hide(struct ili9225_cursor *c);
+
+/**
+ * Show a hidden cursor or hide a visible one. Used for blinking.
+ * \return Whether the cursor is visible afterwards.
+ */
+bool ili9225_cursor_toggle(struct ili9225_cursor *c);
+
+/**
+ * Record pixels written to GRAM in the caches of the cursors they overlap.
+ * Called by the drawing functions of this library; pixels written with
+ * ili9225_write_pixels() or ili9225_dma_write() are not seen.
+ * \param pixels A single colour for ILI9225_CURSOR_SRC_SOLID, else w*h pixels
+ *		in the given layout.
+ */
+void ili9225_cursor_track(uint8_t x, uint8_t y, uint8_t w, uint8_t h,
+	const uint16_t *pixels, ili9225_cursor_src_e src);
+
+#endif
@@ -0,0 +1,141 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#ifndef _MK_ILI9225_FONT_H
+#define _MK_ILI9225_FONT_H
+
+#include "ili9225.h"
+
+/* Most glyphs drawn by one call; the rest of the string is ignored. */
+#ifndef ILI9225_FONT_MAX_GLYPHS
+# define ILI9225_FONT_MAX_GLYPHS 64
+#endif
+
+/* Blend ramps kept for recently used colour pairs of anti-aliased fonts. */
+#ifndef ILI9225_FONT_RAMP_CACHE
+# define ILI9225_FONT_RAMP_CACHE 4
+#endif
+
+/* Glyph bitmaps are run-length encoded. Only valid for 1bpp fonts. */
+#define ILI9225_FONT_RLE	0x01
+/* Glyph pixels are 2 or 4 bit coverage values instead of single bits. */
+#define ILI9225_FONT_2BPP	0x02
+#define ILI9225_FONT_4BPP	0x04
+
+/**
+ * Proportional font, usually generated from a BDF file by
+ * tools/bdf2ili9225.py (see ili9225_add_font() in CMake).
+ *
+ * Each glyph bitmap is a stream of width*height pixels, row by row, one bit
+ * per pixel with the most significant bit first. Rows are not padded.
+ * With ILI9225_FONT_RLE, the stream is stored as bytes where bit 7 is the
+ * pixel value and bits 0-6 are the run length minus one.
+ *
+ * Anti-aliased fonts (ILI9225_FONT_2BPP or ILI9225_FONT_4BPP) store a
+ * coverage value per pixel instead, packed the same way. They are drawn
+ * through a ramp of the colours between bgcolor and color, so text must be
+ * drawn on a background of a known colour.
+ */
+struct ili9225_font_glyph {
+	/* Offset of the bitmap in the font's bitmap blob. */
+	uint32_t offset;
+	uint8_t width;
+	uint8_t height;
+	/* Left edge relative to the pen position. */
+	int8_t x_offset;
+	/* Top edge relative to the top of the line. */
+	int8_t y_offset;
+	/* Pen movement after the glyph. */
+	uint8_t advance;
+};
+
+/**
+ * Kerning pair. Pairs are sorted by left, then right glyph index.
+ */
+struct ili9225_font_kern {
+	uint16_t left;
+	uint16_t right;
+	int8_t adjust;
+};
+
+/**
+ * Run of consecutive codepoints that have glyphs. Ranges are sorted by first
+ * codepoint and do not overlap.
+ */
+struct ili9225_font_range {
+	uint32_t first;
+	uint16_t count;
+	/* Index of the glyph of the first codepoint. */
+	uint16_t glyph;
+};
+
+struct ili9225_font {
+	const uint8_t *bitmap;
+	const struct ili9225_font_glyph *glyphs;
+	const struct ili9225_font_range *ranges;
+	const struct ili9225_font_kern *kern;
+	uint16_t range_count;
+	uint16_t kern_count;
+	/* Glyph drawn for codepoints the font does not have. */
+	uint16_t fallback;
+	uint8_t line_height;
+	uint8_t ascent;
+	uint8_t flags;
+};
+
+/**
+ * Return the glyph index of a codepoint, or font->fallback if the font does
+ * not have it. Takes O(log n) in the number of ranges.
+ */
+uint16_t ili9225_font_glyph_index(const struct ili9225_font *font,
+	uint32_t cp);
+
+/**
+ * Return the width of a UTF-8 string in pixels, including kerning.
+ */
+uint16_t ili9225_font_measure(const struct ili9225_font *font, const char *s);
+
+/**
+ * Return the kerning adjustment between two glyphs, by glyph index.
+ */
+int8_t ili9225_font_kerning(const struct ili9225_font *font, uint16_t left,
+	uint16_t right);
+
+/**
+ * Draw a UTF-8 string with its top left corner at the given coordinates. The
+ * whole string is drawn in one window that is font->line_height pixels high,
+ * glyph rows being decoded straight into line buffers. Text past the right
+ * edge of the screen is clipped. For anti-aliased fonts, each pixel is looked up in
+ * a blend ramp cached per colour pair.
+ * \return Width drawn in pixels.
+ */
+uint16_t ili9225_font_text(const struct ili9225_font *font, const char *s,
+	uint8_t x, uint8_t y, uint16_t color, uint16_t bgcolor);
+
+/**
+ * Draw one line of text into a stream opened with ili9225_stream_begin() on a
+ * rectangle w pixels wide, so that several lines can share one window.
+ * \param len	Number of bytes of s to draw. 0 sends blank rows.
+ * \param x	Pen position of the first glyph within the line. Glyphs
+ *		outside the line are clipped.
+ * \param rows	Number of lines sent, from the top of the text. At most
+ *		font->line_height.
+ */
+void ili9225_font_stream_text(const struct ili9225_font *font, const char *s,
+	size_t len, int16_t x, uint8_t w, uint8_t rows, uint16_t color,
+	uint16_t bgcolor);
+
+#endif
@@ -0,0 +1,57 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#ifndef _MK_ILI9225_FONT8X8_H
+#define _MK_ILI9225_FONT8X8_H
+
+#include <stdint.h>
+
+/* Set to 1 to add glyphs for the Latin-1 Supplement (0xA0 to 0xFF). Must be
+ * defined the same way for the library and the application, for example with
+ * target_compile_definitions(). */
+#ifndef ILI9225_FONT8X8_LATIN1
+# define ILI9225_FONT8X8_LATIN1 0
+#endif
+
+#define ILI9225_FONT8X8_FIRST	0x20
+#if ILI9225_FONT8X8_LATIN1
+# define ILI9225_FONT8X8_LAST	0xFF
+#else
+# define ILI9225_FONT8X8_LAST	0x7E
+#endif
+#define ILI9225_FONT8X8_COUNT	(ILI9225_FONT8X8_LAST - ILI9225_FONT8X8_FIRST + 1)
+
+/**
+ * 8x8 glyphs from ILI9225_FONT8X8_FIRST to ILI9225_FONT8X8_LAST. Each glyph is
+ * 8 rows, top first, with the most significant bit as the leftmost pixel.
+ */
+extern const uint8_t ili9225_font8x8[ILI9225_FONT8X8_COUNT][8];
+
+/**
+ * Return the glyph of a codepoint. Codepoints without a glyph are drawn as a
+ * space.
+ */
+static inline const uint8_t *ili9225_font8x8_glyph(uint32_t c)
+{
+	uint32_t i = c - ILI9225_FONT8X8_FIRST;
+
+	if(i >= ILI9225_FONT8X8_COUNT)
+		i = 0;
+
+	return ili9225_font8x8[i];
+}
+
+#endif
@@ -0,0 +1,64 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#ifndef _MK_ILI9225_GLYPH_CACHE_H
+#define _MK_ILI9225_GLYPH_CACHE_H
+
+#include "ili9225.h"
+
+/* Number of expanded glyphs kept, 128 bytes each. At least 2. */
+#ifndef ILI9225_GLYPH_CACHE_SIZE
+# define ILI9225_GLYPH_CACHE_SIZE 16
+#endif
+
+struct ili9225_glyph_cache_stats {
+	uint32_t hits;
+	uint32_t misses;
+};
+
+/**
+ * Return the glyph of a codepoint in the 8x8 font, expanded to RGB565 in the
+ * given colours.
+ * Glyphs are kept in a fixed pool and the least recently used one is replaced
+ * on a miss.
+ * The pixels are stored column by column, as expected by
+ * ili9225_blit_columns() and ili9225_stream_begin_columns().
+ * \return 64 pixels, valid until ILI9225_GLYPH_CACHE_SIZE - 1 other glyphs
+ *	have been looked up.
+ */
+const uint16_t *ili9225_glyph_cache_get(uint32_t c, uint16_t color,
+	uint16_t bgcolor);
+
+/**
+ * Same as ili9225_text(), but glyphs are taken from the cache. The string is
+ * drawn in one window filled column by column, so each glyph is a single DMA
+ * transfer straight from the cache. Suits text redrawn often in the same
+ * colours, such as clocks and counters.
+ */
+void ili9225_glyph_cache_text(const char *s, uint8_t x, uint8_t y,
+	uint16_t color, uint16_t bgcolor);
+
+/**
+ * Copy the hit and miss counters.
+ */
+void ili9225_glyph_cache_get_stats(struct ili9225_glyph_cache_stats *stats);
+
+/**
+ * Empty the cache and clear the counters.
+ */
+void ili9225_glyph_cache_reset(void);
+
+#endif
@@ -0,0 +1,124 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#ifndef _MK_ILI9225_JPEG_H
+#define _MK_ILI9225_JPEG_H
+
+#include "ili9225.h"
+
+/* Huffman codes up to this long are decoded with a single table lookup. Each
+ * of the four tables takes 2 << ILI9225_JPEG_LOOKUP_BITS bytes. */
+#ifndef ILI9225_JPEG_LOOKUP_BITS
+# define ILI9225_JPEG_LOOKUP_BITS 6
+#endif
+
+typedef enum {
+	ILI9225_JPEG_OK = 0,
+	/* Not a JPEG file, or the file is corrupt or truncated. */
+	ILI9225_JPEG_ERR_FORMAT,
+	/* Progressive, lossless, arithmetic coded or 12-bit JPEG, more than
+	 * one scan, or sampling factors other than listed below. */
+	ILI9225_JPEG_ERR_UNSUPPORTED
+} ili9225_jpeg_err_e;
+
+struct ili9225_jpeg_stats {
+	uint32_t mcus;
+	/* Total time, decoding and sending to the panel. */
+	uint32_t us;
+	/* Part of us spent setting windows and waiting for DMA to the panel;
+	 * us - bus_us is the decode time alone. */
+	uint32_t bus_us;
+};
+
+struct ili9225_jpeg_huff {
+	/* Largest code of each length, or -1 if there are none. */
+	int32_t maxcode[17];
+	/* Index in vals of the first code of each length, minus that code. */
+	int32_t valptr[17];
+	/* Length << 8 | value for codes up to ILI9225_JPEG_LOOKUP_BITS long,
+	 * indexed by the next bits of the stream; 0 for longer codes. */
+	uint16_t lookup[1 << ILI9225_JPEG_LOOKUP_BITS];
+	uint8_t vals[162];
+};
+
+struct ili9225_jpeg_comp {
+	uint8_t id;
+	uint8_t h, v;
+	/* Quantisation and Huffman table numbers. */
+	uint8_t tq, td, ta;
+	/* First block in samples. */
+	uint8_t base;
+	int16_t dc;
+};
+
+/**
+ * Baseline JPEG decoder. Greyscale and YCbCr images are supported, with luma
+ * sampled 1x1, 2x1 or 2x2 times as often as chroma (4:4:4, 4:2:2 and 4:2:0).
+ * Around 2.5 KiB, so it is best not placed on the stack.
+ *
+ * The members are private; use the functions below.
+ */
+struct ili9225_jpeg {
+	const uint8_t *p, *end;
+	uint32_t bits;
+	uint8_t nbits;
+	bool marker;
+	bool error;
+
+	uint16_t width, height;
+	uint16_t restart_interval;
+	uint8_t ncomp;
+	uint8_t hmax, vmax;
+	struct ili9225_jpeg_comp comp[3];
+
+	uint8_t quant[4][64];
+	/* DC tables 0 and 1, then AC tables 0 and 1. */
+	struct ili9225_jpeg_huff huff[4];
+	/* Bit masks of the tables defined so far. */
+	uint8_t quant_defined;
+	uint8_t huff_defined;
+
+	int16_t block[64];
+	/* Up to four luma blocks and one block per chroma component. */
+	uint8_t samples[6][64];
+};
+
+/**
+ * Read the size of a JPEG image from its frame header.
+ * \return false if no baseline or extended sequential frame header is found.
+ */
+bool ili9225_jpeg_info(const uint8_t *data, size_t size, uint16_t *width,
+	uint16_t *height);
+
+/**
+ * Decode a JPEG image onto the screen. Each MCU (minimum coded unit, an 8x8
+ * to 16x16 pixel tile) is converted to RGB565 and written to its own window
+ * by DMA while the next one is decoded, so no framebuffer is needed. Parts of
+ * the image beyond the right or bottom edge of the screen are not drawn, and
+ * their MCUs are only entropy decoded.
+ * \param j	Decoder state.
+ * \param x	Left coordinate of the image on screen.
+ * \param y	Top coordinate of the image on screen.
+ * \param stats	Optional. Receives the number of MCUs decoded, the time
+ *		taken end to end, and how much of it was spent on the bus.
+ * \return ILI9225_JPEG_OK, or an error. Corrupt entropy coded data may
+ *	leave the image partly drawn.
+ */
+ili9225_jpeg_err_e ili9225_jpeg_draw(struct ili9225_jpeg *j,
+	const uint8_t *data, size_t size, uint8_t x, uint8_t y,
+	struct ili9225_jpeg_stats *stats);
+
+#endif
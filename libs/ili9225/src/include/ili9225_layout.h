@@ -0,0 +1,87 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#ifndef _MK_ILI9225_LAYOUT_H
+#define _MK_ILI9225_LAYOUT_H
+
+#include "ili9225_font.h"
+
+/* Most lines in a label. */
+#ifndef ILI9225_LAYOUT_MAX_LINES
+# define ILI9225_LAYOUT_MAX_LINES 16
+#endif
+
+typedef enum {
+	ILI9225_ALIGN_LEFT = 0,
+	ILI9225_ALIGN_CENTER = 1,
+	ILI9225_ALIGN_RIGHT = 2
+} ili9225_align_e;
+
+/**
+ * Text word-wrapped into a box. The line breaks and widths are kept and only
+ * computed again when the text changes, so redrawing a static label does not
+ * measure it again.
+ *
+ * The members are private; use the functions below.
+ */
+struct ili9225_label {
+	const struct ili9225_font *font;
+	uint8_t x, y, w, h;
+	ili9225_align_e align;
+
+	/* Text the layout was computed for. */
+	const char *text;
+	uint32_t hash;
+	bool valid;
+
+	uint8_t line_count;
+	struct {
+		uint16_t start;
+		uint16_t len;
+		uint8_t width;
+	} lines[ILI9225_LAYOUT_MAX_LINES];
+};
+
+/**
+ * Set up a label covering a box of the screen.
+ * \param font	Font of the text. Its lines must fit the box height.
+ */
+void ili9225_label_init(struct ili9225_label *l,
+	const struct ili9225_font *font, uint8_t x, uint8_t y, uint8_t w,
+	uint8_t h, ili9225_align_e align);
+
+/**
+ * Lay out a UTF-8 string in the label, unless it is the text laid out last.
+ * Lines are broken at spaces and newlines, and words wider than the box are
+ * broken between characters. Lines that do not fit the box height are
+ * dropped.
+ * \return Number of lines.
+ */
+uint8_t ili9225_label_layout(struct ili9225_label *l, const char *text);
+
+/**
+ * Return the width of a laid out line in pixels.
+ */
+uint8_t ili9225_label_line_width(const struct ili9225_label *l, uint8_t line);
+
+/**
+ * Lay out a string and draw it. The whole box is written in one window,
+ * the space around the text being filled with bgcolor.
+ */
+void ili9225_label_draw(struct ili9225_label *l, const char *text,
+	uint16_t color, uint16_t bgcolor);
+
+#endif
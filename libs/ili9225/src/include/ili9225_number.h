@@ -0,0 +1,76 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#ifndef _MK_ILI9225_NUMBER_H
+#define _MK_ILI9225_NUMBER_H
+
+#include "ili9225.h"
+
+/* Most character cells of a number field. */
+#ifndef ILI9225_NUMBER_MAX_CELLS
+# define ILI9225_NUMBER_MAX_CELLS 12
+#endif
+
+/**
+ * Number shown in a row of 8x8 character cells. The field remembers the
+ * characters it shows, so updating it only redraws the cells that changed.
+ *
+ * The members are private; use the functions below.
+ */
+struct ili9225_number {
+	uint8_t x, y;
+	uint8_t cells;
+	uint8_t decimals;
+	uint16_t color;
+	uint16_t bgcolor;
+	bool valid;
+	char shown[ILI9225_NUMBER_MAX_CELLS];
+};
+
+/**
+ * Format a fixed-point number right-aligned in a field, padded with spaces on
+ * the left. Values that do not fit fill the field with '#'. No terminator is
+ * written.
+ * \param value	Value multiplied by 10^decimals, so 1234 with 2 decimals is
+ *		"12.34".
+ * \param decimals Number of digits after the decimal point, 0 for an integer.
+ */
+void ili9225_format_fixed(char *buf, uint8_t cells, int32_t value,
+	uint8_t decimals);
+
+/**
+ * Set up a number field. Nothing is drawn until the first value is set.
+ * \param cells	Width of the field in characters, at most
+ *		ILI9225_NUMBER_MAX_CELLS. The field must fit the screen.
+ */
+void ili9225_number_init(struct ili9225_number *n, uint8_t x, uint8_t y,
+	uint8_t cells, uint8_t decimals, uint16_t color, uint16_t bgcolor);
+
+/**
+ * Show a value. Only cells whose character changed are drawn, and adjacent
+ * changed cells share one window, each glyph being sent from the glyph cache.
+ * \param value	Value multiplied by 10^decimals.
+ * \return Number of cells drawn.
+ */
+uint8_t ili9225_number_set(struct ili9225_number *n, int32_t value);
+
+/**
+ * Draw every cell on the next update, for example after the screen was
+ * cleared.
+ */
+void ili9225_number_invalidate(struct ili9225_number *n);
+
+#endif
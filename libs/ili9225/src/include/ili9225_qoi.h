@@ -0,0 +1,45 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#ifndef _MK_ILI9225_QOI_H
+#define _MK_ILI9225_QOI_H
+
+#include "ili9225.h"
+
+/**
+ * Read the size of a QOI image.
+ * \return false if data does not start with a valid QOI header.
+ */
+bool ili9225_qoi_info(const uint8_t *data, size_t size, uint16_t *width,
+	uint16_t *height);
+
+/**
+ * Decode a QOI image straight into a screen window. Pixels are decoded row by
+ * row into one of two buffers while the other is being sent by DMA, and
+ * converted from RGB888 to RGB565 on the way. Alpha is ignored.
+ * \param data	QOI file, such as one made by tools/img2ili9225.py --qoi.
+ * \param x	Left coordinate. The image must fit the screen.
+ * \param y	Top coordinate.
+ * \param dither Apply a 4x4 ordered dither before dropping the low bits of
+ *		each channel, which hides banding in gradients. The pattern is
+ *		tied to screen coordinates.
+ * \return false if the header is invalid, the image does not fit the screen,
+ *	or the data ends early. The window is then only partly drawn.
+ */
+bool ili9225_qoi_blit(const uint8_t *data, size_t size, uint8_t x, uint8_t y,
+	bool dither);
+
+#endif
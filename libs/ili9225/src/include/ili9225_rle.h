@@ -0,0 +1,57 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#ifndef _MK_ILI9225_RLE_H
+#define _MK_ILI9225_RLE_H
+
+#include "ili9225.h"
+
+/* Runs and literals at least this long are sent by DMA straight from the
+ * image data; shorter ones are decoded into a line buffer first. */
+#ifndef ILI9225_RLE_DMA_MIN
+# define ILI9225_RLE_DMA_MIN 32
+#endif
+
+/* Set in a token for a run of one colour, clear for literal pixels. The
+ * remaining bits hold the number of pixels minus one. */
+#define ILI9225_RLE_RUN		0x8000
+#define ILI9225_RLE_COUNT_MASK	0x7FFF
+
+/**
+ * RGB565 image compressed with run-length encoding, as made by
+ * tools/img2ili9225.py. The pixels are coded row by row as one sequence of
+ * tokens, which may cross rows. A run token is followed by its colour; a
+ * literal token by its pixels.
+ */
+struct ili9225_rle_image {
+	const uint16_t *data;
+	/* Length of data in halfwords. */
+	uint32_t size;
+	uint8_t width, height;
+};
+
+/**
+ * Draw an RLE image. Decoding overlaps with sending: short tokens are
+ * decoded into one buffer while the other is being sent, long runs are sent
+ * with DMA repeating their colour, and long literals are sent with DMA
+ * straight from the image data.
+ * \param x	Left coordinate. The image must fit the screen.
+ * \param y	Top coordinate.
+ */
+void ili9225_rle_blit(const struct ili9225_rle_image *img, uint8_t x,
+	uint8_t y);
+
+#endif
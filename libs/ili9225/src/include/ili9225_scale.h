@@ -0,0 +1,48 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#ifndef _MK_ILI9225_SCALE_H
+#define _MK_ILI9225_SCALE_H
+
+#include "ili9225.h"
+
+typedef enum {
+	ILI9225_SCALE_NEAREST = 0,
+	ILI9225_SCALE_BILINEAR = 1
+} ili9225_scale_filter_e;
+
+/**
+ * Copy a framebuffer of any size into a rectangle of any size on screen.
+ * The image is resampled one output line at a time and streamed with DMA, so
+ * the scaled image is never stored in memory.
+ *
+ * Nearest neighbour sampling uses interp0 of the calling core. Its state is
+ * saved and restored.
+ *
+ * \param src	Source pixels in RGB565 format, row by row.
+ * \param src_w	Width of the source in pixels.
+ * \param src_h	Height of the source in pixels.
+ * \param x	Left coordinate on screen.
+ * \param y	Top coordinate on screen.
+ * \param w	Width on screen in pixels.
+ * \param h	Height on screen in pixels.
+ * \param filter Sampling filter.
+ */
+void ili9225_blit_resized(const uint16_t *src, uint16_t src_w, uint16_t src_h,
+	uint8_t x, uint8_t y, uint8_t w, uint8_t h,
+	ili9225_scale_filter_e filter);
+
+#endif
@@ -0,0 +1,77 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#ifndef _MK_ILI9225_SCROLL_H
+#define _MK_ILI9225_SCROLL_H
+
+#include "ili9225.h"
+
+/* Longest wait for the start of a frame before scrolling anyway. */
+#ifndef ILI9225_SCROLL_VSYNC_TIMEOUT_US
+# define ILI9225_SCROLL_VSYNC_TIMEOUT_US 40000
+#endif
+
+/**
+ * Viewport scrolled in hardware over a band of screen rows (columns in
+ * landscape rotations, see ili9225_scroll_region()). Content is addressed in
+ * viewport rows, row 0 being the one shown at the top of the band; after
+ * scrolling, only the rows that came into view need to be drawn.
+ *
+ * The members are private; use the functions below.
+ */
+struct ili9225_scroll {
+	uint8_t top, bottom;
+	uint8_t offset;
+	bool vsync;
+};
+
+/**
+ * Set up a viewport and stop scrolling it.
+ * \param top	First screen row of the band.
+ * \param bottom Last screen row of the band.
+ * \param vsync	Change the scroll registers at the start of a frame, so a
+ *		frame never shows two scroll positions. Needs
+ *		MK_ILI9225_READ_AVAILABLE; ignored otherwise.
+ */
+void ili9225_scroll_init(struct ili9225_scroll *sc, uint8_t top,
+	uint8_t bottom, bool vsync);
+
+/**
+ * Return the number of rows of the viewport.
+ */
+uint8_t ili9225_scroll_height(const struct ili9225_scroll *sc);
+
+/**
+ * Return the screen row to draw at so that the pixels appear at a viewport
+ * row. Rows of the band are contiguous in GRAM except where they wrap from
+ * bottom back to top.
+ */
+uint8_t ili9225_scroll_row(const struct ili9225_scroll *sc, uint8_t row);
+
+/**
+ * Scroll the content up by a number of rows, or down if negative. Rows
+ * scrolled up reappear at the bottom of the viewport with their old content,
+ * so they must be drawn again.
+ */
+void ili9225_scroll_by(struct ili9225_scroll *sc, int16_t rows);
+
+/**
+ * Scroll so that the row drawn at screen row top + offset is shown at the
+ * top of the band.
+ */
+void ili9225_scroll_to(struct ili9225_scroll *sc, uint8_t offset);
+
+#endif
@@ -0,0 +1,84 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+#ifndef _MK_ILI9225_UTF8_H
+#define _MK_ILI9225_UTF8_H
+
+#include <stdint.h>
+
+/* Returned for malformed sequences. */
+#define ILI9225_UTF8_INVALID	0xFFFDu
+
+/**
+ * Decode the next character of a UTF-8 string and advance past it.
+ * Malformed sequences, overlong forms and surrogates decode to
+ * ILI9225_UTF8_INVALID.
+ * \return Codepoint, or 0 at the end of the string, which is not advanced.
+ */
+static inline uint32_t ili9225_utf8_next(const char **s)
+{
+	const uint8_t *p = (const uint8_t *)*s;
+	uint_fast8_t len;
+	uint32_t cp;
+
+	if(p[0] < 0x80)
+	{
+		if(p[0] != 0)
+			(*s)++;
+		return p[0];
+	}
+	else if((p[0] & 0xE0) == 0xC0)
+	{
+		cp = p[0] & 0x1F;
+		len = 2;
+	}
+	else if((p[0] & 0xF0) == 0xE0)
+	{
+		cp = p[0] & 0x0F;
+		len = 3;
+	}
+	else if((p[0] & 0xF8) == 0xF0)
+	{
+		cp = p[0] & 0x07;
+		len = 4;
+	}
+	else
+	{
+		(*s)++;
+		return ILI9225_UTF8_INVALID;
+	}
+
+	/* A terminating NUL also ends a truncated sequence here. */
+	for(uint_fast8_t i = 1; i < len; i++)
+	{
+		if((p[i] & 0xC0) != 0x80)
+		{
+			*s += i;
+			return ILI9225_UTF8_INVALID;
+		}
+		cp = (cp << 6) | (p[i] & 0x3F);
+	}
+
+	*s += len;
+
+	if(cp < (len == 2 ? 0x80u : len == 3 ? 0x800u : 0x10000u) ||
+		(cp >= 0xD800 && cp <= 0xDFFF) || cp > 0x10FFFF)
+		return ILI9225_UTF8_INVALID;
+
+	return cp;
+}
+
+#endif
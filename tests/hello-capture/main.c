@@ -0,0 +1,51 @@
+#include "pico/stdlib.h"
+#include "ili9225.h"
+#include "ili9225_capture.h"
+#include <stdio.h>
+
+// lcd configuration
+const struct ili9225_config lcd_config = {
+    .spi      = spi0,
+    .gpio_din = 19,
+    .gpio_clk = 18,
+    .gpio_cs  = 17,
+    .gpio_rs  = 20,
+    .gpio_rst = 21,
+    .gpio_led = 22
+};
+
+// SPI RX pin wired to the display SDO
+const uint gpio_dout = 16;
+
+uint16_t ili9225_spi_read16(void)
+{
+    uint16_t data;
+    spi_read16_blocking(lcd_config.spi, 0, &data, 1);
+    return data;
+}
+
+int main()
+{
+    stdio_init_all();
+
+    // initialize the lcd
+    ili9225_init(&lcd_config);
+    gpio_set_function(gpio_dout, GPIO_FUNC_SPI);
+
+    // draw something to capture
+    for (uint8_t y = 0; y < ili9225_height(); y += 8) {
+        ili9225_fill_rect(0, y, ili9225_width(), 8, (y / 8) << 11);
+    }
+    ili9225_text("SCREENSHOT", 8, 8, 0xFFFF, 0x0000);
+
+    while (1) {
+        // run tools/ili9225_screenshot.py --port <port> screen.png
+        if (getchar_timeout_us(100 * 1000) == 's') {
+            struct ili9225_capture_stats stats;
+            ili9225_capture_stdio(&stats);
+            printf("\ncaptured %lu px into %lu bytes in %lu us\n",
+                   (unsigned long)stats.pixels, (unsigned long)stats.bytes,
+                   (unsigned long)stats.us);
+        }
+    }
+}
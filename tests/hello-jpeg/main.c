@@ -0,0 +1,53 @@
+#include "pico/stdlib.h"
+#include "ili9225.h"
+#include "ili9225_jpeg.h"
+#include "photo.h"
+#include <stdio.h>
+
+// lcd configuration
+const struct ili9225_config lcd_config = {
+    .spi      = spi0,
+    .gpio_din = 19,
+    .gpio_clk = 18,
+    .gpio_cs  = 17,
+    .gpio_rs  = 20,
+    .gpio_rst = 21,
+    .gpio_led = 22
+};
+
+// decoder state is a few KB, so keep it off the stack
+static struct ili9225_jpeg decoder;
+
+int main()
+{
+    stdio_init_all();
+
+    // initialize the lcd
+    ili9225_init(&lcd_config);
+    ili9225_set_rotation(ILI9225_ROTATION_0);
+
+    while (1) {
+        // decode the photo over and over and report the throughput
+        struct ili9225_jpeg_stats stats;
+        ili9225_jpeg_err_e err = ili9225_jpeg_draw(&decoder, photo,
+                                                   sizeof(photo), 0, 0,
+                                                   &stats);
+        if (err != ILI9225_JPEG_OK) {
+            printf("decode failed: %d\n", err);
+        } else {
+            // end to end includes the SPI transfers; decode only leaves
+            // out the time spent setting windows and waiting for DMA
+            uint32_t decode_us = stats.us - stats.bus_us;
+            printf("%lu MCUs: end to end %lu us, %lu MCUs/s; "
+                   "decode only %lu us, %lu MCUs/s\n",
+                   (unsigned long)stats.mcus, (unsigned long)stats.us,
+                   (unsigned long)((uint64_t)stats.mcus * 1000000 /
+                                   stats.us),
+                   (unsigned long)decode_us,
+                   (unsigned long)(decode_us ? (uint64_t)stats.mcus *
+                                               1000000 / decode_us : 0));
+        }
+
+        sleep_ms(1000);
+    }
+}
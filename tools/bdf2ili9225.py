@@ -0,0 +1,347 @@
+#!/usr/bin/env python3
+"""Convert a BDF bitmap font into C tables for ili9225_font.h.
+
+    bdf2ili9225.py font.bdf --name my_font -o build/fonts [--rle]
+                   [--range 32-126,0xA0-0xFF] [--subset strings.txt ...]
+                   [--kern pairs.txt] [--fallback ?]
+                   [--bpp 1|2|4] [--oversample N]
+
+Writes <name>.c and <name>.h into the output directory. Only codepoints
+in --range that the font has are kept; with --subset, they must also appear
+in one of the given UTF-8 files, such as the string table of a product, so
+the font holds just the glyphs it shows. The kerning file
+holds one pair per line, "left right adjust", where characters are given
+literally or as U+XXXX, for example "A V -1". Lines starting with # are
+ignored.
+
+Anti-aliased fonts are made from a BDF drawn N times larger than the
+wanted size: with --bpp 2 or 4 and --oversample N, each NxN block of the
+source becomes one pixel whose value is the fraction of it that is set.
+Kerning adjustments are given at the source size.
+"""
+
+import argparse
+import os
+import sys
+
+
+class Glyph:
+    def __init__(self):
+        self.encoding = -1
+        self.advance = 0
+        self.bbx = (0, 0, 0, 0)
+        self.rows = []
+
+
+def parse_bdf(path):
+    glyphs = {}
+    ascent = descent = None
+    bbox = None
+    cur = None
+    in_bitmap = False
+
+    with open(path, encoding="latin-1") as f:
+        for line in f:
+            words = line.split()
+            if not words:
+                continue
+            key = words[0]
+
+            if in_bitmap:
+                if key == "ENDCHAR":
+                    in_bitmap = False
+                    if cur.encoding >= 0:
+                        glyphs[cur.encoding] = cur
+                    cur = None
+                else:
+                    cur.rows.append(int(key, 16))
+                continue
+
+            if key == "FONTBOUNDINGBOX":
+                bbox = tuple(int(v) for v in words[1:5])
+            elif key == "FONT_ASCENT":
+                ascent = int(words[1])
+            elif key == "FONT_DESCENT":
+                descent = int(words[1])
+            elif key == "STARTCHAR":
+                cur = Glyph()
+            elif key == "ENCODING" and cur is not None:
+                cur.encoding = int(words[1])
+            elif key == "DWIDTH" and cur is not None:
+                cur.advance = int(words[1])
+            elif key == "BBX" and cur is not None:
+                cur.bbx = tuple(int(v) for v in words[1:5])
+            elif key == "BITMAP":
+                in_bitmap = True
+
+    if ascent is None or descent is None:
+        if bbox is None:
+            raise SystemExit("%s: no ascent, descent or bounding box" % path)
+        ascent = bbox[1] + bbox[3]
+        descent = -bbox[3]
+
+    return glyphs, ascent, descent
+
+
+def glyph_bits(g):
+    """Pixels of a glyph, row by row, as a list of 0/1."""
+    w, h = g.bbx[0], g.bbx[1]
+    row_bits = ((w + 7) // 8) * 8
+    bits = []
+    for r in range(h):
+        row = g.rows[r] if r < len(g.rows) else 0
+        for c in range(w):
+            bits.append((row >> (row_bits - 1 - c)) & 1)
+    return bits
+
+
+def downsample(g, n, levels):
+    """Box filter a glyph by n. Returns the new bounding box and the
+    coverage of each pixel, from 0 to levels - 1."""
+    w, h, xoff, yoff = g.bbx
+    bits = glyph_bits(g)
+    # Cells are aligned on the origin so that glyphs line up.
+    x0, x1 = xoff // n, -(-(xoff + w) // n)
+    y0, y1 = yoff // n, -(-(yoff + h) // n)
+    out = []
+    for cy in range(y1 - 1, y0 - 1, -1):
+        for cx in range(x0, x1):
+            count = 0
+            for sy in range(cy * n, cy * n + n):
+                r = h - 1 - (sy - yoff)
+                if not 0 <= r < h:
+                    continue
+                for sx in range(cx * n, cx * n + n):
+                    c = sx - xoff
+                    if 0 <= c < w:
+                        count += bits[r * w + c]
+            out.append((count * (levels - 1) + n * n // 2) // (n * n))
+    return (x1 - x0, y1 - y0, x0, y0), out
+
+
+def pack_raw(values, bpp=1):
+    out = bytearray()
+    per_byte = 8 // bpp
+    for i in range(0, len(values), per_byte):
+        byte = 0
+        for j, v in enumerate(values[i:i + per_byte]):
+            byte |= v << (8 - bpp * (j + 1))
+        out.append(byte)
+    return bytes(out)
+
+
+def pack_rle(bits):
+    out = bytearray()
+    i = 0
+    while i < len(bits):
+        val = bits[i]
+        n = 1
+        while i + n < len(bits) and bits[i + n] == val and n < 128:
+            n += 1
+        out.append((val << 7) | (n - 1))
+        i += n
+    return bytes(out)
+
+
+def parse_ranges(text):
+    cps = set()
+    for part in text.split(","):
+        lo, _, hi = part.partition("-")
+        lo = int(lo, 0)
+        hi = int(hi, 0) if hi else lo
+        cps.update(range(lo, hi + 1))
+    return cps
+
+
+def group_ranges(cps):
+    """Split sorted codepoints into (first, count) runs."""
+    runs = []
+    for cp in cps:
+        if runs and runs[-1][0] + runs[-1][1] == cp:
+            runs[-1][1] += 1
+        else:
+            runs.append([cp, 1])
+    return runs
+
+
+def parse_char(text):
+    if text.upper().startswith("U+"):
+        return int(text[2:], 16)
+    if len(text) == 1:
+        return ord(text)
+    return int(text, 0)
+
+
+def parse_kern(path):
+    pairs = []
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            left, right, adjust = line.split()
+            pairs.append((parse_char(left), parse_char(right), int(adjust)))
+    return pairs
+
+
+def c_char(cp):
+    if 0x20 < cp < 0x7F and chr(cp) not in "\\*/":
+        return " '%s'" % chr(cp)
+    return ""
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawTextHelpFormatter)
+    ap.add_argument("bdf")
+    ap.add_argument("--name", required=True, help="C identifier of the font")
+    ap.add_argument("-o", "--output", default=".", help="output directory")
+    ap.add_argument("--range", default="32-126",
+                    help="codepoints to include, as comma separated ranges "
+                         "(default: %(default)s)")
+    ap.add_argument("--subset", nargs="+", metavar="FILE",
+                    help="keep only characters used in these UTF-8 files")
+    ap.add_argument("--rle", action="store_true",
+                    help="run-length encode glyph bitmaps")
+    ap.add_argument("--kern", help="kerning pairs file")
+    ap.add_argument("--fallback", default="?",
+                    help="character drawn for missing glyphs")
+    ap.add_argument("--bpp", type=int, choices=(1, 2, 4), default=1,
+                    help="bits per pixel (default: %(default)s)")
+    ap.add_argument("--oversample", type=int, default=1,
+                    help="source pixels per output pixel, for --bpp 2 or 4")
+    args = ap.parse_args()
+
+    n = args.oversample
+    if args.rle and args.bpp != 1:
+        raise SystemExit("--rle needs --bpp 1")
+    if n < 1 or (n > 1 and args.bpp == 1):
+        raise SystemExit("--oversample needs --bpp 2 or 4")
+
+    glyphs, ascent, descent = parse_bdf(args.bdf)
+    ascent, descent = -(-ascent // n), -(-descent // n)
+    wanted = parse_ranges(args.range)
+    if args.subset:
+        used = set()
+        for path in args.subset:
+            with open(path, encoding="utf-8") as f:
+                used.update(ord(ch) for ch in f.read())
+        wanted &= used
+    fallback_cp = parse_char(args.fallback)
+    if fallback_cp not in glyphs:
+        raise SystemExit("fallback glyph %r not in font" % args.fallback)
+    wanted.add(fallback_cp)
+    cps = sorted(cp for cp in wanted if cp in glyphs)
+    index = {cp: i for i, cp in enumerate(cps)}
+    if len(cps) > 0xFFFF:
+        raise SystemExit("too many glyphs")
+
+    blob = bytearray()
+    entries = []
+    offsets = {}
+    for cp in cps:
+        g = glyphs[cp]
+        if args.bpp == 1:
+            w, h, xoff, yoff = g.bbx
+            bits = glyph_bits(g)
+            data = pack_rle(bits) if args.rle else pack_raw(bits)
+        else:
+            (w, h, xoff, yoff), cov = downsample(g, n, 1 << args.bpp)
+            data = pack_raw(cov, args.bpp)
+        # Identical bitmaps are stored once.
+        if data not in offsets:
+            offsets[data] = len(blob)
+            blob += data
+        top = ascent - (yoff + h)
+        if not (-128 <= xoff < 128 and -128 <= top < 128):
+            raise SystemExit("glyph %d out of range" % cp)
+        advance = (g.advance + n // 2) // n
+        entries.append((cp, (offsets[data], w, h, xoff, top, advance)))
+
+    ranges = group_ranges(cps)
+
+    kern = []
+    if args.kern:
+        for left, right, adjust in parse_kern(args.kern):
+            adjust = round(adjust / n)
+            if left in index and right in index and adjust:
+                kern.append((index[left], index[right], adjust))
+        kern.sort()
+
+    name = args.name
+    os.makedirs(args.output, exist_ok=True)
+    src = []
+    src.append("/* Generated by bdf2ili9225.py from %s. Do not edit. */"
+               % os.path.basename(args.bdf))
+    src.append("")
+    src.append('#include "%s.h"' % name)
+    src.append("")
+    src.append("static const uint8_t %s_bitmap[] = {" % name)
+    for i in range(0, len(blob), 12):
+        src.append("\t" + ", ".join("0x%02X" % b for b in blob[i:i + 12]) + ",")
+    if not blob:
+        src.append("\t0")
+    src.append("};")
+    src.append("")
+    src.append("static const struct ili9225_font_glyph %s_glyphs[] = {"
+               % name)
+    for cp, (off, w, h, xoff, top, adv) in entries:
+        src.append("\t{ %d, %d, %d, %d, %d, %d },\t/* U+%04X%s */"
+                   % (off, w, h, xoff, top, adv, cp, c_char(cp)))
+    src.append("};")
+    src.append("")
+    src.append("static const struct ili9225_font_range %s_ranges[] = {"
+               % name)
+    for first, count in ranges:
+        src.append("\t{ 0x%04X, %d, %d }," % (first, count, index[first]))
+    src.append("};")
+    src.append("")
+    if kern:
+        src.append("static const struct ili9225_font_kern %s_kern[] = {"
+                   % name)
+        for left, right, adjust in kern:
+            src.append("\t{ %d, %d, %d }," % (left, right, adjust))
+        src.append("};")
+        src.append("")
+    src.append("const struct ili9225_font %s = {" % name)
+    src.append("\t.bitmap = %s_bitmap," % name)
+    src.append("\t.glyphs = %s_glyphs," % name)
+    src.append("\t.ranges = %s_ranges," % name)
+    src.append("\t.kern = %s," % ("%s_kern" % name if kern else "NULL"))
+    src.append("\t.range_count = %d," % len(ranges))
+    src.append("\t.kern_count = %d," % len(kern))
+    src.append("\t.fallback = %d," % index[fallback_cp])
+    src.append("\t.line_height = %d," % (ascent + descent))
+    src.append("\t.ascent = %d," % ascent)
+    flags = {1: "0", 2: "ILI9225_FONT_2BPP", 4: "ILI9225_FONT_4BPP"}[args.bpp]
+    if args.rle:
+        flags = "ILI9225_FONT_RLE"
+    src.append("\t.flags = %s," % flags)
+    src.append("};")
+
+    hdr = []
+    guard = "_%s_H" % name.upper()
+    hdr.append("/* Generated by bdf2ili9225.py from %s. Do not edit. */"
+               % os.path.basename(args.bdf))
+    hdr.append("")
+    hdr.append("#ifndef %s" % guard)
+    hdr.append("#define %s" % guard)
+    hdr.append("")
+    hdr.append('#include "ili9225_font.h"')
+    hdr.append("")
+    hdr.append("extern const struct ili9225_font %s;" % name)
+    hdr.append("")
+    hdr.append("#endif")
+
+    with open(os.path.join(args.output, name + ".c"), "w") as f:
+        f.write("\n".join(src) + "\n")
+    with open(os.path.join(args.output, name + ".h"), "w") as f:
+        f.write("\n".join(hdr) + "\n")
+
+    print("%s: %d glyphs in %d ranges, %d bitmap bytes, %d kerning pairs"
+          % (name, len(entries), len(ranges), len(blob), len(kern)),
+          file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
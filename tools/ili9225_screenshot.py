@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""Decode a screenshot captured with ili9225_capture() to PPM or PNG.
+
+The stream is read from a file, or from a serial port (requires pyserial),
+for example the USB CDC port of a board running tests/hello-capture:
+
+    ili9225_screenshot.py --port /dev/ttyACM0 screen.png
+    ili9225_screenshot.py --input dump.bin screen.ppm
+"""
+
+import argparse
+import struct
+import sys
+import time
+import zlib
+
+MAGIC = b"I9SC"
+TRAILER = b"DONE"
+VERSION = 1
+
+
+class Reader:
+    def __init__(self, read):
+        self._read = read
+
+    def take(self, n):
+        data = b""
+        while len(data) < n:
+            chunk = self._read(n - len(data))
+            if not chunk:
+                raise EOFError("stream ended early")
+            data += chunk
+        return data
+
+    def sync(self):
+        """Skip any text printed before the header."""
+        window = b""
+        while window != MAGIC:
+            window = (window + self.take(1))[-len(MAGIC):]
+
+
+def decode(reader):
+    reader.sync()
+    version, width, height = struct.unpack("<BHH", reader.take(5))
+    if version != VERSION:
+        raise ValueError("unsupported version %d" % version)
+
+    count = width * height
+    pixels = []
+    while len(pixels) < count:
+        ctrl = reader.take(1)[0]
+        n = (ctrl & 0x7F) + 1
+        if ctrl & 0x80:
+            pixels.extend(struct.unpack("<H", reader.take(2)) * n)
+        else:
+            pixels.extend(struct.unpack("<%dH" % n, reader.take(2 * n)))
+
+    if len(pixels) != count:
+        raise ValueError("packet crosses end of image")
+
+    if reader.take(4) != TRAILER:
+        raise ValueError("missing trailer")
+    total, us = struct.unpack("<II", reader.take(8))
+    if total != count:
+        raise ValueError("pixel count mismatch")
+
+    return width, height, pixels, us
+
+
+def to_rgb888(pixels):
+    out = bytearray()
+    for p in pixels:
+        r = (p >> 11) & 0x1F
+        g = (p >> 5) & 0x3F
+        b = p & 0x1F
+        out += bytes(((r << 3) | (r >> 2), (g << 2) | (g >> 4),
+                      (b << 3) | (b >> 2)))
+    return bytes(out)
+
+
+def write_ppm(path, width, height, rgb):
+    with open(path, "wb") as f:
+        f.write(b"P6\n%d %d\n255\n" % (width, height))
+        f.write(rgb)
+
+
+def write_png(path, width, height, rgb):
+    def chunk(tag, data):
+        body = tag + data
+        return (struct.pack(">I", len(data)) + body +
+                struct.pack(">I", zlib.crc32(body) & 0xFFFFFFFF))
+
+    stride = width * 3
+    raw = b"".join(b"\x00" + rgb[y * stride:(y + 1) * stride]
+                   for y in range(height))
+    with open(path, "wb") as f:
+        f.write(b"\x89PNG\r\n\x1a\n")
+        f.write(chunk(b"IHDR", struct.pack(">IIBBBBB", width, height,
+                                           8, 2, 0, 0, 0)))
+        f.write(chunk(b"IDAT", zlib.compress(raw, 9)))
+        f.write(chunk(b"IEND", b""))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawTextHelpFormatter)
+    src = ap.add_mutually_exclusive_group(required=True)
+    src.add_argument("--port", help="serial port to read from")
+    src.add_argument("--input", help="file to read from, '-' for stdin")
+    ap.add_argument("--trigger", default="s",
+                    help="text sent to the port to start a capture "
+                         "(default: %(default)s)")
+    ap.add_argument("output", help="output image, .png or .ppm")
+    args = ap.parse_args()
+
+    start = time.monotonic()
+    if args.port:
+        import serial
+        port = serial.Serial(args.port, timeout=10)
+        port.reset_input_buffer()
+        port.write(args.trigger.encode())
+        width, height, pixels, us = decode(Reader(port.read))
+    else:
+        f = sys.stdin.buffer if args.input == "-" else open(args.input, "rb")
+        width, height, pixels, us = decode(Reader(f.read))
+    elapsed = time.monotonic() - start
+
+    rgb = to_rgb888(pixels)
+    if args.output.lower().endswith(".png"):
+        write_png(args.output, width, height, rgb)
+    else:
+        write_ppm(args.output, width, height, rgb)
+
+    print("%dx%d px, device %.1f ms (%.0f px/s), host %.1f ms"
+          % (width, height, us / 1000.0,
+             width * height / (us / 1e6) if us else 0, elapsed * 1000.0),
+          file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
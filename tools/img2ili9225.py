@@ -0,0 +1,308 @@
+#!/usr/bin/env python3
+"""Convert an image into an RLE-compressed RGB565 image for ili9225_rle.h,
+or a QOI image for ili9225_qoi.h, or embed a JPEG file for ili9225_jpeg.h.
+
+    img2ili9225.py logo.png --name logo -o build/images [--qoi]
+
+Reads 8-bit non-interlaced PNG (greyscale, RGB, palette, with or without
+alpha) or binary PPM files, and writes <name>.c and <name>.h into the output
+directory. Alpha is ignored. Pixels are coded row by row as tokens: a run of
+one colour, or a number of literal pixels.
+
+With --qoi, the full RGB888 colours are kept and the image is declared as
+a byte array holding a QOI file, which suits photographs better. It is
+drawn with ili9225_qoi_blit(name, sizeof(name), ...).
+
+JPEG files are embedded unchanged as a byte array, to be drawn with
+ili9225_jpeg_draw(&decoder, name, sizeof(name), ...).
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+RLE_RUN = 0x8000
+MAX_COUNT = 0x8000
+# Shorter runs are cheaper kept in a literal.
+MIN_RUN = 3
+
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def read_png(data):
+    pos = 8
+    idat = b""
+    palette = None
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, ctype, _, _, interlace = \
+                struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b"IDAT":
+            idat += body
+        elif kind == b"IEND":
+            break
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}.get(ctype)
+    if depth != 8 or channels is None or interlace:
+        sys.exit("unsupported PNG: only 8-bit non-interlaced images")
+
+    raw = zlib.decompress(idat)
+    stride = width * channels
+    prev = bytearray(stride)
+    pixels = []
+    for y in range(height):
+        off = y * (stride + 1)
+        ftype = raw[off]
+        line = bytearray(raw[off + 1:off + 1 + stride])
+        for i in range(stride):
+            a = line[i - channels] if i >= channels else 0
+            b = prev[i]
+            c = prev[i - channels] if i >= channels else 0
+            if ftype == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif ftype == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif ftype == 3:
+                line[i] = (line[i] + ((a + b) >> 1)) & 0xFF
+            elif ftype == 4:
+                line[i] = (line[i] + paeth(a, b, c)) & 0xFF
+        prev = line
+        for x in range(0, stride, channels):
+            px = line[x:x + channels]
+            if ctype == 3:
+                pixels.append(palette[px[0]])
+            elif channels <= 2:
+                pixels.append((px[0], px[0], px[0]))
+            else:
+                pixels.append(tuple(px[:3]))
+    return width, height, pixels
+
+
+def read_ppm(data):
+    fields = []
+    pos = 2
+    while len(fields) < 3:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b"#":
+            pos = data.index(b"\n", pos)
+            continue
+        start = pos
+        while not data[pos:pos + 1].isspace():
+            pos += 1
+        fields.append(int(data[start:pos]))
+    width, height, maxval = fields
+    if maxval != 255:
+        sys.exit("unsupported PPM: maximum value must be 255")
+    pos += 1
+    pixels = [tuple(data[i:i + 3])
+              for i in range(pos, pos + width * height * 3, 3)]
+    return width, height, pixels
+
+
+def jpeg_size(data):
+    pos = 2
+    while pos + 4 <= len(data):
+        if data[pos] != 0xFF:
+            break
+        marker = data[pos + 1]
+        if marker == 0xFF:
+            pos += 1
+            continue
+        length = struct.unpack(">H", data[pos + 2:pos + 4])[0]
+        if 0xC0 <= marker <= 0xCF and marker not in (0xC4, 0xC8, 0xCC):
+            height, width = struct.unpack(">HH", data[pos + 5:pos + 9])
+            return width, height
+        pos += 2 + length
+    sys.exit("JPEG file has no frame header")
+
+
+def rgb565(r, g, b):
+    return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+
+
+def encode(pixels):
+    out = []
+    literal = []
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:MAX_COUNT]
+            del literal[:MAX_COUNT]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+
+    i = 0
+    while i < len(pixels):
+        j = i + 1
+        while j < len(pixels) and pixels[j] == pixels[i] and \
+                j - i < MAX_COUNT:
+            j += 1
+        if j - i >= MIN_RUN:
+            flush_literal()
+            out.append(RLE_RUN | (j - i - 1))
+            out.append(pixels[i])
+        else:
+            literal.extend(pixels[i:j])
+        i = j
+    flush_literal()
+    return out
+
+
+def qoi_encode(width, height, pixels):
+    out = bytearray(b"qoif")
+    out += struct.pack(">IIBB", width, height, 3, 0)
+    index = [None] * 64
+    prev = (0, 0, 0)
+    run = 0
+
+    for n, px in enumerate(pixels):
+        if px == prev:
+            run += 1
+            if run == 62 or n == len(pixels) - 1:
+                out.append(0xC0 | (run - 1))
+                run = 0
+            continue
+        if run:
+            out.append(0xC0 | (run - 1))
+            run = 0
+
+        r, g, b = px
+        h = (r * 3 + g * 5 + b * 7 + 255 * 11) % 64
+        if index[h] == px:
+            out.append(h)
+        else:
+            index[h] = px
+            dr = (r - prev[0] + 128) % 256 - 128
+            dg = (g - prev[1] + 128) % 256 - 128
+            db = (b - prev[2] + 128) % 256 - 128
+            if -2 <= dr <= 1 and -2 <= dg <= 1 and -2 <= db <= 1:
+                out.append(0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2))
+            elif -32 <= dg <= 31 and -8 <= dr - dg <= 7 and \
+                    -8 <= db - dg <= 7:
+                out.append(0x80 | (dg + 32))
+                out.append((dr - dg + 8) << 4 | (db - dg + 8))
+            else:
+                out += bytes((0xFE, r, g, b))
+        prev = px
+
+    out += bytes(7) + b"\x01"
+    return bytes(out)
+
+
+def c_rle(name, width, height, pixels):
+    tokens = encode([rgb565(*p) for p in pixels])
+    src = []
+    src.append("static const uint16_t %s_data[] = {" % name)
+    for i in range(0, len(tokens), 8):
+        src.append("\t" + ", ".join("0x%04X" % t for t in tokens[i:i + 8])
+                   + ",")
+    src.append("};")
+    src.append("")
+    src.append("const struct ili9225_rle_image %s = {" % name)
+    src.append("\t.data = %s_data," % name)
+    src.append("\t.size = %d," % len(tokens))
+    src.append("\t.width = %d," % width)
+    src.append("\t.height = %d," % height)
+    src.append("};")
+    decl = ('#include "ili9225_rle.h"',
+            "extern const struct ili9225_rle_image %s;" % name)
+    return src, decl, len(tokens) * 2
+
+
+def c_bytes(name, blob, include):
+    src = []
+    src.append("const uint8_t %s[%d] = {" % (name, len(blob)))
+    for i in range(0, len(blob), 12):
+        src.append("\t" + ", ".join("0x%02X" % b for b in blob[i:i + 12])
+                   + ",")
+    src.append("};")
+    decl = ('#include "%s"' % include,
+            "extern const uint8_t %s[%d];" % (name, len(blob)))
+    return src, decl, len(blob)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawTextHelpFormatter)
+    ap.add_argument("image")
+    ap.add_argument("--name", required=True, help="C identifier of the image")
+    ap.add_argument("-o", "--output", default=".", help="output directory")
+    ap.add_argument("--qoi", action="store_true",
+                    help="write a QOI file instead of RLE tokens")
+    args = ap.parse_args()
+
+    with open(args.image, "rb") as f:
+        data = f.read()
+    name = args.name
+    if data.startswith(b"\xff\xd8\xff"):
+        # Embedded unchanged; photos larger than the screen are clipped
+        # when drawn.
+        width, height = jpeg_size(data)
+        body, decl, size = c_bytes(name, data, "ili9225_jpeg.h")
+    else:
+        if data.startswith(b"\x89PNG\r\n\x1a\n"):
+            width, height, pixels = read_png(data)
+        elif data.startswith(b"P6"):
+            width, height, pixels = read_ppm(data)
+        else:
+            sys.exit("%s: not a PNG, binary PPM or JPEG file" % args.image)
+
+        if not 0 < width <= 220 or not 0 < height <= 220:
+            sys.exit("image must be at most 220 pixels wide and high")
+
+        if args.qoi:
+            body, decl, size = c_bytes(
+                name, qoi_encode(width, height, pixels), "ili9225_qoi.h")
+        else:
+            body, decl, size = c_rle(name, width, height, pixels)
+
+    os.makedirs(args.output, exist_ok=True)
+
+    src = []
+    src.append("/* Generated by img2ili9225.py from %s. Do not edit. */"
+               % os.path.basename(args.image))
+    src.append("")
+    src.append('#include "%s.h"' % name)
+    src.append("")
+    src.extend(body)
+
+    hdr = []
+    guard = "_%s_H" % name.upper()
+    hdr.append("/* Generated by img2ili9225.py from %s. Do not edit. */"
+               % os.path.basename(args.image))
+    hdr.append("")
+    hdr.append("#ifndef %s" % guard)
+    hdr.append("#define %s" % guard)
+    hdr.append("")
+    hdr.append(decl[0])
+    hdr.append("")
+    hdr.append(decl[1])
+    hdr.append("")
+    hdr.append("#endif")
+
+    with open(os.path.join(args.output, name + ".c"), "w") as f:
+        f.write("\n".join(src) + "\n")
+    with open(os.path.join(args.output, name + ".h"), "w") as f:
+        f.write("\n".join(hdr) + "\n")
+
+    print("%s: %dx%d, %d bytes (%d uncompressed)"
+          % (name, width, height, size, width * height * 2),
+          file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
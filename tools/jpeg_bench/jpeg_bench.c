@@ -0,0 +1,120 @@
+/**
+ * Copyright (C) 2019-2022 by Mahyar Koshkouei <mk@deltabeard.com>
+ * 
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+/**
+ * Host benchmark of ili9225_jpeg_draw(). The stream functions the decoder
+ * sends MCUs through are stubbed out, so this measures decoding and colour
+ * conversion alone, on the host CPU. It says nothing absolute about the
+ * RP2040; use it to compare changes to the decoder. Build and run with:
+ *
+ *	make -C tools/jpeg_bench
+ *	tools/jpeg_bench/jpeg_bench tests/hello-jpeg/photo.jpg [iterations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "pico/time.h"
+#include "ili9225.h"
+#include "ili9225_jpeg.h"
+
+#define MAX_FILE_SIZE (1024 * 1024)
+
+static volatile uint16_t sink;
+
+uint8_t ili9225_width(void)
+{
+	return 176;
+}
+
+uint8_t ili9225_height(void)
+{
+	return 220;
+}
+
+void ili9225_stream_begin(uint8_t x, uint8_t y, uint8_t w, uint8_t h)
+{
+	(void)x;
+	(void)y;
+	(void)w;
+	(void)h;
+}
+
+void ili9225_stream_pixels(const uint16_t *pixels, size_t len)
+{
+	/* Read the converted pixels so the work cannot be optimised out. */
+	sink = pixels[len - 1];
+}
+
+void ili9225_stream_end(void)
+{
+}
+
+static uint8_t file[MAX_FILE_SIZE];
+static struct ili9225_jpeg decoder;
+
+int main(int argc, char **argv)
+{
+	struct ili9225_jpeg_stats stats;
+	ili9225_jpeg_err_e err;
+	unsigned long iterations = 1000;
+	uint64_t start, us;
+	size_t size;
+	FILE *f;
+
+	if(argc < 2 || argc > 3)
+	{
+		fprintf(stderr, "usage: %s file.jpg [iterations]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	if(argc == 3)
+		iterations = strtoul(argv[2], NULL, 0);
+
+	f = fopen(argv[1], "rb");
+	if(f == NULL)
+	{
+		perror(argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	size = fread(file, 1, sizeof(file), f);
+	fclose(f);
+
+	/* Warm up, and check the file decodes at all. */
+	err = ili9225_jpeg_draw(&decoder, file, size, 0, 0, &stats);
+	if(err != ILI9225_JPEG_OK)
+	{
+		fprintf(stderr, "%s: decode failed: %d\n", argv[1], err);
+		return EXIT_FAILURE;
+	}
+
+	start = time_us_64();
+	for(unsigned long i = 0; i < iterations; i++)
+		ili9225_jpeg_draw(&decoder, file, size, 0, 0, &stats);
+	us = time_us_64() - start;
+
+	if(us == 0)
+		us = 1;
+
+	printf("%s: %lu x %lu MCUs in %llu us, %.0f MCUs/s, %.1f images/s\n",
+		argv[1], iterations, (unsigned long)stats.mcus,
+		(unsigned long long)us,
+		(double)stats.mcus * iterations * 1e6 / us,
+		(double)iterations * 1e6 / us);
+
+	return EXIT_SUCCESS;
+}